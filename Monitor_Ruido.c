@@ -7,7 +7,6 @@
  */
 
 #include <stdio.h>
-#include <math.h>  // Para log10() e fabs()
 #include <string.h> // Para strlen
 #include "pico/stdlib.h"
 #include "hardware/adc.h"
@@ -15,14 +14,25 @@
 #include "pico/bootrom.h"
 #include "hardware/pwm.h"
 #include "hardware/i2c.h"
+#include "hardware/sync.h"
 #include "lib/ssd1306.h"
 #include "wifi_config.h"  // Adicione esta linha
+#include "estatisticas.h"
+#include "captura_audio.h"
+#include "agendador.h"
+#include "dsp_ruido.h"
+#include "telemetria.h"
+#include "servidor_http.h"
+#include "ui.h"
+#include "fluxo_pcm.h"
+#include "baixo_consumo.h"
 
 // Definições de pinos
 #define BUZZER_A 21   // Buzzer A no GPIO21
 #define BUZZER_B 10   // Buzzer B no GPIO10
 #define BUTTON_A 5    // Botão A no GPIO5
 #define BUTTON_B 6    // Botão B no GPIO6
+#define BUTTON_JOYSTICK 22 // Botão do joystick no GPIO22: troca a tela do display
 
 const uint LED_RED   = 13;
 const uint LED_BLUE  = 12;
@@ -37,7 +47,22 @@ const uint NUM_AMOSTRAS = 100;
 #define WIDTH  128
 #define HEIGHT 64
 
-#define FILTER_SIZE 10
+// Períodos das tarefas do agendador (em microssegundos)
+#define PERIODO_BOTOES_US      50000     // 20 Hz, também serve de debounce
+#define PERIODO_COMANDOS_US    50000     // 20 Hz, comandos recebidos pela USB
+#define PERIODO_DSP_US         10000     // 100 Hz, um bloco de medição
+#define PERIODO_DISPLAY_US     100000    // 10 Hz
+#define PERIODO_TELEMETRIA_US  1000000   // 1 Hz
+#define PERIODO_MANUTENCAO_US  10000000  // 0,1 Hz
+
+// Modo de baixo consumo (compilado com -DMODO_BAIXO_CONSUMO=ON): ciclo de trabalho e lote
+#define BAIXO_CONSUMO_PERIODO_US   10000000  // Uma janela a cada 10 s
+#define BAIXO_CONSUMO_JANELA_US    2000000   // 2 s medindo (20% do tempo)
+#define BAIXO_CONSUMO_LOTE         30        // Rádio sai do power-save a cada 30 janelas (5 min)
+
+// Níveis estatísticos: intervalos de 1 minuto, agregados em blocos de 1 hora
+#define INTERVALO_ESTAT_MS   60000
+#define INTERVALOS_POR_HORA  60
 
 ssd1306_t ssd;
 
@@ -49,79 +74,423 @@ bool led_vermelho_ligado = false; // Estado do LED vermelho
 extern volatile uint16_t adc_value;
 extern volatile float amplitude;
 extern volatile float db_spl;
+extern volatile float rejeicao_buzzer_db;
 
-// --- Funções auxiliares ---
+// Histogramas dos níveis de curta duração (memória constante)
+static estat_histograma_t hist_intervalo;
+static estat_histograma_t hist_hora;
 
-// Pequeno atraso para debounce
-void debounce_delay() {
-    sleep_ms(50);
-}
+// Estado compartilhado entre as tarefas
+static agendador_t agendador;
+static float limiar_1, limiar_2, limiar_3;   // Em dB SPL, comparados ao nível já sem o buzzer
+static uint16_t mic_value = 0;
+static float noiseFiltered = 0.0f; // Valor RMS (em contagens) do sinal AC no último bloco
+static float noise_dBSPL = 0.0f;   // Nível em dB SPL
+static uint32_t inicio_intervalo_ms = 0;
+
+// Telas do display e widgets de cada uma (índices retornados por ui_adicionar)
+enum { TELA_NIVEIS, TELA_ESTATISTICAS, TELA_REDE, NUM_TELAS };
+static ui_t ui;
+static struct {
+    int ln, db_spl, limiar[3], buzzer;
+    int l10[2], l50[2], l90[2], maximo[2], rejeicao;
+    int wifi, ip, http_ativas, http_recusadas;
+} painel;
+
+// --- Funções auxiliares ---
 
-// Emite som via PWM no buzzer (configurado para aproximadamente 2000 Hz)
+// Emite som via PWM no buzzer (aproximadamente 1 kHz; ver DSP_BUZZER_FREQUENCIA_HZ)
 void emitir_som_buzzer(uint buzzer_pin) {
-    gpio_set_function(buzzer_pin, GPIO_FUNC_PWM);
     uint slice_num = pwm_gpio_to_slice_num(buzzer_pin);
-    pwm_set_clkdiv(slice_num, 125.0f);
-    pwm_set_wrap(slice_num, 1000);
-    pwm_set_chan_level(slice_num, PWM_CHAN_A, 900); // 90% de duty cycle
-    pwm_set_enabled(slice_num, true);
+    if (gpio_get_function(buzzer_pin) != GPIO_FUNC_PWM) {
+        gpio_set_function(buzzer_pin, GPIO_FUNC_PWM);
+        pwm_set_clkdiv(slice_num, (float)DSP_BUZZER_CLKDIV);
+        pwm_set_wrap(slice_num, DSP_BUZZER_WRAP);
+        pwm_set_enabled(slice_num, true);
+    }
+    pwm_set_gpio_level(buzzer_pin, 900); // 90% de duty cycle
+    buzzer_ativo = true;
 }
 
-// Para o som do buzzer
+// Para o som do buzzer. O contador do PWM continua rodando com o nível em zero: a fase do tom
+// não muda entre um alarme e outro, e o cancelador reaproveita a forma de onda já aprendida.
 void parar_som_buzzer(uint buzzer_pin) {
-    uint slice_num = pwm_gpio_to_slice_num(buzzer_pin);
-    pwm_set_enabled(slice_num, false);
+    pwm_set_gpio_level(buzzer_pin, 0);
+    buzzer_ativo = false;
 }
 
 // Calibração do ruído ambiente: lê NUM_AMOSTRAS e calcula a média, que deverá ser próxima de 2048
 uint16_t calibrar_ruido() {
     uint32_t soma = 0;
-    for (int i = 0; i < NUM_AMOSTRAS; i++) {
+    for (uint i = 0; i < NUM_AMOSTRAS; i++) {
         adc_select_input(2); // ADC2 (GPIO28)
         soma += adc_read();
     }
     return soma / NUM_AMOSTRAS;
 }
 
-// Filtro móvel simples (média dos últimos FILTER_SIZE valores)
-// Agora usamos para filtrar a amplitude (valor absoluto) do sinal AC
-float filterNoise(float newValue) {
-    static float values[FILTER_SIZE];
-    static int index = 0;
-    static int count = 0;
-    float sum = 0.0f;
-    values[index] = newValue;
-    index = (index + 1) % FILTER_SIZE;
-    if (count < FILTER_SIZE) count++;
-    for (int i = 0; i < count; i++) {
-        sum += values[i];
+// Fecha o intervalo estatístico atual: publica L10/L50/L90, agrega na hora e reinicia o intervalo
+void fechar_intervalo_estatistico(void) {
+    static int intervalos_na_hora = 0;
+    estat_niveis_t niveis;
+
+    estat_calcular_niveis(&hist_intervalo, &niveis);
+    niveis_intervalo = niveis;
+    printf("[ESTAT] Intervalo: L10 %.1f | L50 %.1f | L90 %.1f dB (%lu amostras)\n",
+           niveis.l10, niveis.l50, niveis.l90, (unsigned long)niveis.amostras);
+
+    estat_mesclar(&hist_hora, &hist_intervalo);
+    estat_reset(&hist_intervalo);
+
+    if (++intervalos_na_hora >= INTERVALOS_POR_HORA) {
+        estat_calcular_niveis(&hist_hora, &niveis);
+        niveis_hora = niveis;
+        printf("[ESTAT] Hora: L10 %.1f | L50 %.1f | L90 %.1f dB\n", niveis.l10, niveis.l50, niveis.l90);
+        estat_reset(&hist_hora);
+        intervalos_na_hora = 0;
+    }
+}
+
+// Saída da interface no SSD1306: a UI só conhece caracteres 8x8 e regiões
+static void ui_caractere(void *contexto, char c, uint8_t x, uint8_t y) {
+    ssd1306_draw_char((ssd1306_t *)contexto, c, x, y);
+}
+
+static void ui_limpar(void *contexto) {
+    ssd1306_fill((ssd1306_t *)contexto, false);
+    ssd1306_draw_border((ssd1306_t *)contexto);
+}
+
+static void ui_enviar(void *contexto, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    ssd1306_send_region((ssd1306_t *)contexto, x0, y0, x1, y1);
+}
+
+// Monta as telas; as posições seguem o layout original (linhas a cada 10 px)
+void configurar_telas(void) {
+    ui_saida_t saida = { ui_caractere, ui_limpar, ui_enviar, &ssd, WIDTH, HEIGHT };
+    ui_iniciar(&ui, &saida, NUM_TELAS);
+
+    // Níveis: L10/L50/L90 do último intervalo, nível atual, limiares e buzzer
+    painel.ln = ui_adicionar(&ui, TELA_NIVEIS, 8, 5, "L ", 11);   // "136 132 128"
+    painel.db_spl = ui_adicionar(&ui, TELA_NIVEIS, 10, 15, "dB SPL ", 6);
+    painel.limiar[0] = ui_adicionar(&ui, TELA_NIVEIS, 10, 25, "Medio   ", 4);
+    painel.limiar[1] = ui_adicionar(&ui, TELA_NIVEIS, 10, 35, "Alto    ", 4);
+    painel.limiar[2] = ui_adicionar(&ui, TELA_NIVEIS, 10, 45, "Extremo ", 4);
+    painel.buzzer = ui_adicionar(&ui, TELA_NIVEIS, 15, 55, "Buzzer  ", 3);
+
+    // Estatísticas: intervalo (esquerda) e hora (direita)
+    ui_adicionar(&ui, TELA_ESTATISTICAS, 8, 5, "    Int  Hora", 0);
+    const char *rotulos[] = { "L10 ", "L50 ", "L90 ", "Max " };
+    int *linhas[] = { painel.l10, painel.l50, painel.l90, painel.maximo };
+    for (int i = 0; i < 4; i++) {
+        linhas[i][0] = ui_adicionar(&ui, TELA_ESTATISTICAS, 8, 15 + 10 * i, rotulos[i], 4);
+        linhas[i][1] = ui_adicionar(&ui, TELA_ESTATISTICAS, 80, 15 + 10 * i, NULL, 4);
+    }
+    painel.rejeicao = ui_adicionar(&ui, TELA_ESTATISTICAS, 8, 55, "Notch dB ", 4);
+
+    // Rede: Wi-Fi, IP e conexões do servidor HTTP
+    painel.wifi = ui_adicionar(&ui, TELA_REDE, 8, 5, "WiFi ", 3);
+    ui_adicionar(&ui, TELA_REDE, 8, 15, "IP", 0);
+    painel.ip = ui_adicionar(&ui, TELA_REDE, 4, 25, NULL, 15);
+    painel.http_ativas = ui_adicionar(&ui, TELA_REDE, 8, 40, "HTTP ativas ", 2);
+    painel.http_recusadas = ui_adicionar(&ui, TELA_REDE, 8, 50, "Recusadas ", 4);
+}
+
+// --- Tarefas do agendador ---
+
+// Botões lidos por borda de descida; o período da tarefa faz o debounce sem bloquear
+void tarefa_botoes(void *contexto) {
+    (void)contexto;
+    static bool a_anterior = false;
+    static bool b_anterior = false;
+    static bool joystick_anterior = false;
+    bool a = !gpio_get(BUTTON_A);
+    bool b = !gpio_get(BUTTON_B);
+    bool joystick = !gpio_get(BUTTON_JOYSTICK);
+
+    // Botão A: ativa/desativa o buzzer
+    if (a && !a_anterior) {
+        if (!buzzer_ligado) {
+            printf("[BOTÃO A] Pressionado! Emitindo som no buzzer.\n");
+            emitir_som_buzzer(BUZZER_A);
+            emitir_som_buzzer(BUZZER_B);
+            buzzer_ligado = true;
+        } else {
+            printf("[BOTÃO A] Pressionado! Parando som no buzzer.\n");
+            parar_som_buzzer(BUZZER_A);
+            parar_som_buzzer(BUZZER_B);
+            buzzer_ligado = false;
+        }
+    }
+
+    // Botão B: entra no modo BOOTSEL
+    if (b && !b_anterior) {
+        printf("[BOTÃO B] Pressionado! Entrando em modo BOOTSEL.\n");
+        reset_usb_boot(0, 0);
+    }
+
+    // Joystick: próxima tela do display
+    if (joystick && !joystick_anterior) {
+        ui_proxima_tela(&ui);
+    }
+
+    a_anterior = a;
+    b_anterior = b;
+    joystick_anterior = joystick;
+}
+
+// Medição: nível, estatísticas, captura de áudio e controle de LEDs/buzzer
+void tarefa_dsp(void *contexto) {
+    (void)contexto;
+    // Comprime o trecho de áudio de um disparo já concluído
+    if (captura_processar()) {
+        printf("[CAPTURA] Trecho de áudio armazenado.\n");
+    }
+
+    // Nível em dB SPL: cada bloco de 10 ms passa pelo pipeline DSP (DC, banda, decimação, RMS, dB)
+    uint16_t bloco[DSP_AMOSTRAS_BLOCO];
+    while (captura_ler_bloco(bloco, DSP_AMOSTRAS_BLOCO)) {
+        // Modo de calibração: o bloco bruto também sai pela USB, sem interromper a medição
+        fluxo_pcm_enviar(captura_indice_bloco(), bloco, DSP_AMOSTRAS_BLOCO);
+
+        // Com o buzzer ligado, o tom dele é removido antes do nível para não realimentar o alarme
+        dsp_cancelar_buzzer(buzzer_ativo);
+        noise_dBSPL = dsp_processar_bloco(bloco, &noiseFiltered);
+        telemetria_acumular(noise_dBSPL);
+
+        // Acumula o nível no histograma e fecha o intervalo quando o tempo expira
+        estat_adicionar(&hist_intervalo, noise_dBSPL);
+        uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+        if (agora_ms - inicio_intervalo_ms >= INTERVALO_ESTAT_MS) {
+            fechar_intervalo_estatistico();
+            inicio_intervalo_ms = agora_ms;
+        }
+    }
+
+    // Lê o valor do microfone (valor bruto do ADC: 0 a 4095)
+    mic_value = captura_media_recente(10); // Média das 10 últimas amostras para suavizar
+
+    // Atualiza as variáveis globais
+    adc_value = mic_value;
+    amplitude = noiseFiltered;
+    db_spl = noise_dBSPL;
+    rejeicao_buzzer_db = dsp_rejeicao_buzzer_db();
+
+    // Controle dos LEDs e buzzer com base no nível em dB SPL. O tom do buzzer já foi removido
+    // dele; o valor bruto do ADC ainda contém o tom e manteria o alarme tocando sozinho.
+    if (noise_dBSPL > limiar_1 && noise_dBSPL < limiar_2) {
+        gpio_put(LED_BLUE, true);
+        gpio_put(LED_RED, false);
+        gpio_put(LED_GREEN, false);
+        if (!buzzer_ligado) {
+            parar_som_buzzer(BUZZER_A);
+            parar_som_buzzer(BUZZER_B);
+        }
+    }
+    else if (noise_dBSPL >= limiar_2 && noise_dBSPL < limiar_3) {
+        gpio_put(LED_BLUE, false);
+        gpio_put(LED_RED, true);
+        gpio_put(LED_GREEN, false);
+        if (!buzzer_ligado) {
+            parar_som_buzzer(BUZZER_A);
+            parar_som_buzzer(BUZZER_B);
+        }
+    }
+    else if (noise_dBSPL >= limiar_3) {
+        // Congela o áudio antes e depois da ultrapassagem
+        captura_disparar(noise_dBSPL);
+        gpio_put(LED_BLUE, false);
+        gpio_put(LED_RED, true);
+        gpio_put(LED_GREEN, false);
+        if (!buzzer_ligado) {
+            emitir_som_buzzer(BUZZER_A);
+            emitir_som_buzzer(BUZZER_B);
+        }
+    }
+    else { // noise_dBSPL <= limiar_1
+        gpio_put(LED_BLUE, false);
+        gpio_put(LED_RED, false);
+        gpio_put(LED_GREEN, true);
+        if (!buzzer_ligado) {
+            parar_som_buzzer(BUZZER_A);
+            parar_som_buzzer(BUZZER_B);
+        }
+    }
+}
+
+// Atualiza os valores dos widgets; só o que mudou é redesenhado e enviado ao display
+void tarefa_display(void *contexto) {
+    (void)contexto;
+    char buffer[UI_MAX_CARACTERES + 1];
+
+    snprintf(buffer, sizeof(buffer), "%3.0f %3.0f %3.0f", niveis_intervalo.l10, niveis_intervalo.l50, niveis_intervalo.l90);
+    ui_texto(&ui, painel.ln, buffer);
+    ui_numero(&ui, painel.db_spl, "%.1f", noise_dBSPL);
+    ui_texto(&ui, painel.buzzer, buzzer_ligado ? "ON" : "OFF");
+
+    const volatile estat_niveis_t *niveis[] = { &niveis_intervalo, &niveis_hora };
+    for (int i = 0; i < 2; i++) {
+        ui_numero(&ui, painel.l10[i], "%.0f", niveis[i]->l10);
+        ui_numero(&ui, painel.l50[i], "%.0f", niveis[i]->l50);
+        ui_numero(&ui, painel.l90[i], "%.0f", niveis[i]->l90);
+        ui_numero(&ui, painel.maximo[i], "%.0f", niveis[i]->maximo);
+    }
+    ui_numero(&ui, painel.rejeicao, "%.0f", rejeicao_buzzer_db);
+
+    ui_texto(&ui, painel.wifi, wifi_conectado ? "ON" : "OFF");
+    uint8_t *ip = (uint8_t *)&(cyw43_state.netif[0].ip_addr.addr);
+    snprintf(buffer, sizeof(buffer), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]); // Pontos saem em branco na fonte
+    ui_texto(&ui, painel.ip, buffer);
+    servidor_http_estatisticas_t http;
+    servidor_http_estatisticas(&http);
+    ui_numero(&ui, painel.http_ativas, "%.0f", (float)http.ativas);
+    ui_numero(&ui, painel.http_recusadas, "%.0f", (float)http.recusadas);
+
+    ui_desenhar(&ui);
+}
+
+// Comandos pela USB: liga/desliga o fluxo de amostras brutas
+void tarefa_comandos(void *contexto) {
+    (void)contexto;
+    fluxo_pcm_verificar_comandos();
+}
+
+// Logs para verificar a consistência dos valores e envio do Leq do último segundo ao coletor
+void tarefa_telemetria(void *contexto) {
+    (void)contexto;
+    printf("ADC Bruto: %d | Amplitude: %.1f | dB SPL: %.1f\n", mic_value, noiseFiltered, noise_dBSPL);
+    if (buzzer_ativo) {
+        printf("[BUZZER] Tom cancelado: %.1f dB removidos da medicao\n", rejeicao_buzzer_db);
+    }
+    telemetria_enviar();
+}
+
+// Relatório periódico do agendador (estouros e jitter por tarefa)
+void tarefa_manutencao(void *contexto) {
+    (void)contexto;
+    for (int i = 0; i < agendador.num_tarefas; i++) {
+        agendador_tarefa_t *t = &agendador.tarefas[i];
+        printf("[AGENDADOR] %-10s exec: %lu | estouros: %lu | jitter med/max: %lu/%lu us | duracao max: %lu us\n",
+               t->nome, (unsigned long)t->execucoes, (unsigned long)t->estouros,
+               (unsigned long)(t->execucoes ? t->jitter_soma_us / t->execucoes : 0),
+               (unsigned long)t->jitter_max_us, (unsigned long)t->duracao_max_us);
     }
-    return sum / count;
+    agendador_zerar_estatisticas(&agendador);
+
+    printf("[UI] quadros: %lu | pixels no ultimo: %lu | media por quadro: %lu\n",
+           (unsigned long)ui.quadros, (unsigned long)ui.pixels_quadro,
+           (unsigned long)(ui.quadros ? ui.pixels_total / ui.quadros : 0));
+    ui_zerar_estatisticas(&ui);
+
+    if (fluxo_pcm_ativo()) {
+        fluxo_pcm_estatisticas_t fluxo;
+        fluxo_pcm_estatisticas(&fluxo);
+        printf("[FLUXO] pacotes: %lu | descartados: %lu\n",
+               (unsigned long)fluxo.pacotes, (unsigned long)fluxo.descartados);
+    }
+}
+
+// Relógio do agendador e despertar do __wfe() no prazo seguinte
+static uint64_t relogio_us(void) {
+    return time_us_64();
+}
+
+static int64_t despertar_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    __sev();
+    return 0;
 }
 
-// Função para converter a amplitude (em contagens do ADC) em dB SPL
-// "adc_amplitude" deve ser o valor absoluto (em contagens) do sinal AC filtrado.
-float convertToDBSPL(uint16_t adc_amplitude) {
-    // Converte contagens para tensão (ADC de 12 bits, Vref = 3.3V)
-    float voltage = adc_amplitude * (3.3f / 4095.0f);
-    // Sensibilidade do microfone (em V/Pa). Ajuste conforme o seu microfone.
-    const float MIC_SENSITIVITY = 0.007f; // Exemplo: 7 mV/Pa
-    // Converte tensão para pressão sonora (Pa)
-    float pressure = voltage / MIC_SENSITIVITY;
-    // Pressão de referência para 0 dB SPL em ar: 20 µPa
-    const float pref = 20e-6f;
-    if (pressure <= 0) pressure = 1e-9f; // Evita log de zero
-    float dbSPL = 20.0f * log10(pressure / pref);
-    return dbSPL;
+// Dorme até o instante dado; outras interrupções (ADC, Wi-Fi) também acordam o núcleo
+static void dormir_ate(uint64_t instante) {
+    alarm_id_t alarme = add_alarm_at(from_us_since_boot(instante), despertar_callback, NULL, false);
+    while (time_us_64() < instante) {
+        __wfe();
+    }
+    if (alarme > 0) cancel_alarm(alarme);
 }
 
-// Função auxiliar para centralizar texto no display com deslocamento opcional no eixo X
-void draw_centered_string(ssd1306_t *ssd, const char *str, int y, int x_offset) {
-    int len = strlen(str);
-    int x = ((WIDTH - (len * 6)) / 2) + x_offset; // Cada caractere tem aproximadamente 6 pixels de largura
-    ssd1306_draw_string(ssd, str, x, y);
+#ifdef MODO_BAIXO_CONSUMO
+static baixo_consumo_t baixo_consumo;
+
+// Tira o rádio do power-save, envia as leituras guardadas com a idade de cada uma e volta
+static void enviar_lote(void) {
+    cyw43_wifi_pm(&cyw43_state, CYW43_PERFORMANCE_PM);
+    baixo_consumo_radio(&baixo_consumo, true);
+
+    const baixo_consumo_resultado_t *lote;
+    int n = baixo_consumo_lote(&baixo_consumo, &lote);
+    uint64_t agora = time_us_64();
+    int enviadas = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t idade_s = (uint32_t)((agora - lote[i].instante_us) / 1000000);
+        if (telemetria_enviar_medicao(lote[i].leq, lote[i].maximo, idade_s > 0 ? idade_s : 1)) enviadas++;
+    }
+    printf("[BAIXO CONSUMO] Lote enviado: %d de %d leituras\n", enviadas, n);
+    baixo_consumo_esvaziar_lote(&baixo_consumo);
+
+    cyw43_wifi_pm(&cyw43_state, CYW43_AGGRESSIVE_PM);
+    baixo_consumo_radio(&baixo_consumo, false);
 }
 
+// Substitui o agendador: mede em janelas, dorme entre elas com o ADC parado e o display
+// desligado, e só tira o rádio do power-save para enviar um lote
+static void laco_baixo_consumo(void) {
+    const baixo_consumo_config_t config = {
+        .periodo_us = BAIXO_CONSUMO_PERIODO_US,
+        .janela_us = BAIXO_CONSUMO_JANELA_US,
+        .janelas_por_lote = BAIXO_CONSUMO_LOTE,
+        // Estimativas para a Pico W em 3,3 V; medir na placa para um relatório fiel
+        .corrente_acordado_ma = 25.0f,
+        .corrente_dormindo_ma = 12.0f,
+        .corrente_radio_ma = 45.0f,
+        .tensao_v = 3.3f,
+    };
+    baixo_consumo_iniciar(&baixo_consumo, &config, relogio_us);
+
+    ssd1306_command(&ssd, SET_DISP | 0x00);
+    cyw43_wifi_pm(&cyw43_state, CYW43_AGGRESSIVE_PM);
+    printf("[BAIXO CONSUMO] Janela de %lu ms a cada %lu ms, lote de %d janelas\n",
+           (unsigned long)(config.janela_us / 1000), (unsigned long)(config.periodo_us / 1000),
+           config.janelas_por_lote);
+
+    while (true) {
+        uint64_t fim = baixo_consumo_abrir_janela(&baixo_consumo);
+        captura_pausar(false);
+        for (uint64_t prazo = time_us_64(); prazo < fim; prazo += PERIODO_DSP_US) {
+            dormir_ate(prazo);
+            tarefa_dsp(NULL);
+        }
+        captura_pausar(true);
+
+        // Alarme visual e sonoro não ficam ligados durante o sono
+        gpio_put(LED_BLUE, false);
+        gpio_put(LED_RED, false);
+        gpio_put(LED_GREEN, false);
+        parar_som_buzzer(BUZZER_A);
+        parar_som_buzzer(BUZZER_B);
+
+        float leq, maximo;
+        if (telemetria_fechar(&leq, &maximo) &&
+            baixo_consumo_fechar_janela(&baixo_consumo, leq, maximo)) {
+            enviar_lote();
+        }
+
+        baixo_consumo_contas_t contas;
+        if (baixo_consumo_relatorio(&baixo_consumo, &contas)) {
+            printf("[BAIXO CONSUMO] Hora: acordado %lu s | dormindo %lu s | radio %lu s | "
+                   "%lu janelas | %lu lotes | %.1f mWh\n",
+                   (unsigned long)(contas.acordado_us / 1000000), (unsigned long)(contas.dormindo_us / 1000000),
+                   (unsigned long)(contas.radio_us / 1000000), (unsigned long)contas.janelas,
+                   (unsigned long)contas.lotes, contas.energia_mwh);
+        }
+
+        dormir_ate(baixo_consumo_dormir(&baixo_consumo));
+    }
+}
+#endif
+
 int main() {
     stdio_init_all();
 
@@ -147,6 +516,9 @@ int main() {
     gpio_init(BUTTON_B);
     gpio_set_dir(BUTTON_B, GPIO_IN);
     gpio_pull_up(BUTTON_B);
+    gpio_init(BUTTON_JOYSTICK);
+    gpio_set_dir(BUTTON_JOYSTICK, GPIO_IN);
+    gpio_pull_up(BUTTON_JOYSTICK);
 
     // Configura o I2C para o display OLED
     i2c_init(I2C_PORT, 400 * 1000);
@@ -165,142 +537,43 @@ int main() {
     ruido_base = calibrar_ruido();  // Este valor deve ser próximo de 2048
     printf("Ruído base calibrado: %d\n", ruido_base);
 
-    // Defina limiares para controle dos LEDs e buzzer (esses valores podem ser ajustados)
-    uint16_t limiar_1 = ruido_base + 100;   // Por exemplo, para acionar LED azul
-    uint16_t limiar_2 = 3000; // Para acionar LED vermelho
-    uint16_t limiar_3 = 4000;              // Para acionar LED vermelho e buzzer
+    telemetria_iniciar();
 
-    float noiseFiltered = 0.0f; // Valor filtrado (em contagens) da amplitude AC
-    float noise_dBSPL = 0.0f;   // Nível em dB SPL
+    // A partir daqui o ADC amostra continuamente e alimenta o anel de pré-disparo
+    captura_iniciar(ruido_base);
 
-    while (true) {
-        // Botão A: ativa/desativa o buzzer
-        if (!gpio_get(BUTTON_A)) {
-            debounce_delay();
-            if (!buzzer_ligado) {
-                printf("[BOTÃO A] Pressionado! Emitindo som no buzzer.\n");
-                emitir_som_buzzer(BUZZER_A);
-                emitir_som_buzzer(BUZZER_B);
-                buzzer_ligado = true;
-            } else {
-                printf("[BOTÃO A] Pressionado! Parando som no buzzer.\n");
-                parar_som_buzzer(BUZZER_A);
-                parar_som_buzzer(BUZZER_B);
-                buzzer_ligado = false;
-            }
-            while (!gpio_get(BUTTON_A)) {
-                sleep_ms(10);
-            }
-        }
-        
-        // Botão B: entra no modo BOOTSEL
-        if (!gpio_get(BUTTON_B)) {
-            debounce_delay();
-            printf("[BOTÃO B] Pressionado! Entrando em modo BOOTSEL.\n");
-            reset_usb_boot(0, 0);
-        }
-        
-        // Lê o valor do microfone (valor bruto do ADC: 0 a 4095)
-        adc_select_input(2);
-        uint16_t mic_value = 0;
-        for (int i = 0; i < 10; i++) { // Média de 10 leituras para suavizar
-            mic_value += adc_read();
-            sleep_us(10); // Reduzido o atraso entre leituras
-        }
-        mic_value /= 10;
-        
-        // Verificação adicional para valores fora do esperado
-        if (mic_value > 4095 || mic_value < 0 || mic_value < ruido_base) {
-            printf("Valor do ADC fora do intervalo esperado ou abaixo do ruído base: %d\n", mic_value);
-            continue; // Ignora esta leitura
-        }
+    // Defina limiares para controle dos LEDs e buzzer (esses valores podem ser ajustados).
+    // Equivalem aos antigos limiares em contagens: ~100, ~670 e ~1380 contagens RMS acima do offset.
+    limiar_1 = 115.0f;   // Por exemplo, para acionar LED azul
+    limiar_2 = 132.0f;   // Para acionar LED vermelho
+    limiar_3 = 138.0f;   // Para acionar LED vermelho e buzzer
 
-        // Calcula o sinal AC: subtrai o offset (ruído_base)
-        int16_t sample = (int16_t)mic_value - (int16_t)ruido_base;
-        // Calcula o valor absoluto (amplitude) do sinal AC
-        float abs_sample = fabs((float)sample);
-        // Aplica o filtro móvel para suavizar a medição (em contagens)
-        noiseFiltered = filterNoise(abs_sample);
-        // Converte a amplitude filtrada em dB SPL
-        noise_dBSPL = convertToDBSPL((uint16_t)noiseFiltered);
-        
-        // Adiciona logs para verificar a consistência dos valores
-        printf("ADC Bruto: %d | Amplitude: %.1f | dB SPL: %.1f\n", mic_value, noiseFiltered, noise_dBSPL);
-        
-        // Atualiza as variáveis globais
-        adc_value = mic_value;
-        amplitude = noiseFiltered;
-        db_spl = noise_dBSPL;
-        
-        // Controle dos LEDs e buzzer com base no valor bruto (você pode também usar o dB SPL)
-        if (mic_value > limiar_1 && mic_value < limiar_2) {
-            gpio_put(LED_BLUE, true);
-            gpio_put(LED_RED, false);
-            gpio_put(LED_GREEN, false);
-            if (!buzzer_ligado) {
-                parar_som_buzzer(BUZZER_A);
-                parar_som_buzzer(BUZZER_B);
-            }
-        }
-        else if (mic_value >= limiar_2 && mic_value < limiar_3) {
-            gpio_put(LED_BLUE, false);
-            gpio_put(LED_RED, true);
-            gpio_put(LED_GREEN, false);
-            if (!buzzer_ligado) {
-                parar_som_buzzer(BUZZER_A);
-                parar_som_buzzer(BUZZER_B);
-            }
-        }
-        else if (mic_value >= limiar_3) {
-            gpio_put(LED_BLUE, false);
-            gpio_put(LED_RED, true);
-            gpio_put(LED_GREEN, false);
-            if (!buzzer_ligado) {
-                emitir_som_buzzer(BUZZER_A);
-                emitir_som_buzzer(BUZZER_B);
-            }
-        }
-        else { // mic_value <= limiar_1
-            gpio_put(LED_BLUE, false);
-            gpio_put(LED_RED, false);
-            gpio_put(LED_GREEN, true);
-            if (!buzzer_ligado) {
-                parar_som_buzzer(BUZZER_A);
-                parar_som_buzzer(BUZZER_B);
-            }
-        }
-        
-        // Atualiza o display OLED com informações
-        ssd1306_draw_border(&ssd); // Desenha a borda ao redor do display
-        char buffer[32];
-        snprintf(buffer, sizeof(buffer), "ADC:    %d", mic_value);
-        draw_centered_string(&ssd, buffer, 5, -15);
-        
-        // Desenha o texto fixo "dB SPL:"
-        ssd1306_draw_string(&ssd, "dB SPL:", 10, 15);
-        // Desenha o valor numérico na mesma linha
-        snprintf(buffer, sizeof(buffer), "  %.1f", noise_dBSPL);
-        ssd1306_draw_string(&ssd, buffer, 60, 15); // Ajuste a posição x conforme necessário
-        
-        snprintf(buffer, sizeof(buffer), "Medio:  %d", limiar_1);
-        draw_centered_string(&ssd, buffer, 25, -13); // Exibe o limiar 1
-        snprintf(buffer, sizeof(buffer), "Alto:   %d", limiar_2);
-        draw_centered_string(&ssd, buffer, 35, -13); // Exibe o limiar 2
-        snprintf(buffer, sizeof(buffer), "Extremo:%d", limiar_3);
-        draw_centered_string(&ssd, buffer, 45, -13); // Exibe o limiar 3
-        
-        // Desenha o texto fixo "Buzzer:"
-        ssd1306_draw_string(&ssd, "Buzzer:", 15, 55); // Ajuste a posição x conforme necessário
-        // Limpa a área onde o estado do buzzer será exibido
-        ssd1306_fill_rect(&ssd, 90, 53, 30, 10, false); // Ajuste a altura para 16 pixels e a posição Y para 53
-        // Desenha o estado do buzzer
-        snprintf(buffer, sizeof(buffer), "%s", buzzer_ligado ? "ON" : "OFF");
-        ssd1306_draw_string(&ssd, buffer, 88, 55); // Ajuste a posição x conforme necessário
-
-        ssd1306_send_data(&ssd);
-        
-        sleep_ms(10); // Reduzido o tempo de espera no loop principal
+    // Os limiares não mudam: são desenhados uma vez, na primeira vez que a tela aparecer
+    configurar_telas();
+    ui_numero(&ui, painel.limiar[0], "%.0f", limiar_1);
+    ui_numero(&ui, painel.limiar[1], "%.0f", limiar_2);
+    ui_numero(&ui, painel.limiar[2], "%.0f", limiar_3);
+
+    estat_reset(&hist_intervalo);
+    estat_reset(&hist_hora);
+    inicio_intervalo_ms = to_ms_since_boot(get_absolute_time());
+
+#ifdef MODO_BAIXO_CONSUMO
+    laco_baixo_consumo();
+#endif
+
+    // Cada atividade roda no seu próprio período, em vez de tudo a cada sleep_ms(10)
+    agendador_iniciar(&agendador, relogio_us);
+    agendador_adicionar(&agendador, "botoes", tarefa_botoes, NULL, PERIODO_BOTOES_US);
+    agendador_adicionar(&agendador, "dsp", tarefa_dsp, NULL, PERIODO_DSP_US);
+    agendador_adicionar(&agendador, "comandos", tarefa_comandos, NULL, PERIODO_COMANDOS_US);
+    agendador_adicionar(&agendador, "display", tarefa_display, NULL, PERIODO_DISPLAY_US);
+    agendador_adicionar(&agendador, "telemetria", tarefa_telemetria, NULL, PERIODO_TELEMETRIA_US);
+    agendador_adicionar(&agendador, "manutencao", tarefa_manutencao, NULL, PERIODO_MANUTENCAO_US);
+
+    while (true) {
+        dormir_ate(agendador_executar(&agendador));
     }
-    
+
     return 0;
 }
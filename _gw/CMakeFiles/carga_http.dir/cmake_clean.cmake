@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/carga_http.dir/carga_http.c.o"
+  "CMakeFiles/carga_http.dir/carga_http.c.o.d"
+  "carga_http"
+  "carga_http.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/carga_http.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
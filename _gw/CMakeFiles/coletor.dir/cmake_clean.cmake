@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/coletor.dir/agregador.c.o"
+  "CMakeFiles/coletor.dir/agregador.c.o.d"
+  "CMakeFiles/coletor.dir/coletor.c.o"
+  "CMakeFiles/coletor.dir/coletor.c.o.d"
+  "coletor"
+  "coletor.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/coletor.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/gravador_wav.dir/gravador_wav.c.o"
+  "CMakeFiles/gravador_wav.dir/gravador_wav.c.o.d"
+  "gravador_wav"
+  "gravador_wav.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/gravador_wav.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/simulador.dir/simulador.c.o"
+  "CMakeFiles/simulador.dir/simulador.c.o.d"
+  "simulador"
+  "simulador.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/simulador.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
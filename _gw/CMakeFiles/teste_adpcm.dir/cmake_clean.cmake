@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_adpcm.dir/root/repo/lib/adpcm.c.o"
+  "CMakeFiles/teste_adpcm.dir/root/repo/lib/adpcm.c.o.d"
+  "CMakeFiles/teste_adpcm.dir/root/repo/lib/captura_audio.c.o"
+  "CMakeFiles/teste_adpcm.dir/root/repo/lib/captura_audio.c.o.d"
+  "CMakeFiles/teste_adpcm.dir/testes/pico_falso/pico_falso.c.o"
+  "CMakeFiles/teste_adpcm.dir/testes/pico_falso/pico_falso.c.o.d"
+  "CMakeFiles/teste_adpcm.dir/testes/teste_adpcm.c.o"
+  "CMakeFiles/teste_adpcm.dir/testes/teste_adpcm.c.o.d"
+  "teste_adpcm"
+  "teste_adpcm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_adpcm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
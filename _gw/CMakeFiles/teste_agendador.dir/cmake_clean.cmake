@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_agendador.dir/root/repo/lib/agendador.c.o"
+  "CMakeFiles/teste_agendador.dir/root/repo/lib/agendador.c.o.d"
+  "CMakeFiles/teste_agendador.dir/testes/teste_agendador.c.o"
+  "CMakeFiles/teste_agendador.dir/testes/teste_agendador.c.o.d"
+  "teste_agendador"
+  "teste_agendador.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_agendador.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_agregador.dir/agregador.c.o"
+  "CMakeFiles/teste_agregador.dir/agregador.c.o.d"
+  "CMakeFiles/teste_agregador.dir/testes/teste_agregador.c.o"
+  "CMakeFiles/teste_agregador.dir/testes/teste_agregador.c.o.d"
+  "teste_agregador"
+  "teste_agregador.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_agregador.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/baixo_consumo.c" "CMakeFiles/teste_baixo_consumo.dir/root/repo/lib/baixo_consumo.c.o" "gcc" "CMakeFiles/teste_baixo_consumo.dir/root/repo/lib/baixo_consumo.c.o.d"
+  "/root/repo/host/testes/teste_baixo_consumo.c" "CMakeFiles/teste_baixo_consumo.dir/testes/teste_baixo_consumo.c.o" "gcc" "CMakeFiles/teste_baixo_consumo.dir/testes/teste_baixo_consumo.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
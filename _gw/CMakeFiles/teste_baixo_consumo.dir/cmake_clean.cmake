@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_baixo_consumo.dir/root/repo/lib/baixo_consumo.c.o"
+  "CMakeFiles/teste_baixo_consumo.dir/root/repo/lib/baixo_consumo.c.o.d"
+  "CMakeFiles/teste_baixo_consumo.dir/testes/teste_baixo_consumo.c.o"
+  "CMakeFiles/teste_baixo_consumo.dir/testes/teste_baixo_consumo.c.o.d"
+  "teste_baixo_consumo"
+  "teste_baixo_consumo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_baixo_consumo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
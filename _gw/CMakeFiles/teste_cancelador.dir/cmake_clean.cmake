@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_cancelador.dir/root/repo/lib/dsp_ruido.cpp.o"
+  "CMakeFiles/teste_cancelador.dir/root/repo/lib/dsp_ruido.cpp.o.d"
+  "CMakeFiles/teste_cancelador.dir/testes/teste_cancelador.c.o"
+  "CMakeFiles/teste_cancelador.dir/testes/teste_cancelador.c.o.d"
+  "teste_cancelador"
+  "teste_cancelador.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/teste_cancelador.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/adpcm.c" "CMakeFiles/teste_captura.dir/root/repo/lib/adpcm.c.o" "gcc" "CMakeFiles/teste_captura.dir/root/repo/lib/adpcm.c.o.d"
+  "/root/repo/lib/captura_audio.c" "CMakeFiles/teste_captura.dir/root/repo/lib/captura_audio.c.o" "gcc" "CMakeFiles/teste_captura.dir/root/repo/lib/captura_audio.c.o.d"
+  "/root/repo/host/testes/pico_falso/pico_falso.c" "CMakeFiles/teste_captura.dir/testes/pico_falso/pico_falso.c.o" "gcc" "CMakeFiles/teste_captura.dir/testes/pico_falso/pico_falso.c.o.d"
+  "/root/repo/host/testes/teste_captura.c" "CMakeFiles/teste_captura.dir/testes/teste_captura.c.o" "gcc" "CMakeFiles/teste_captura.dir/testes/teste_captura.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_captura.dir/root/repo/lib/adpcm.c.o"
+  "CMakeFiles/teste_captura.dir/root/repo/lib/adpcm.c.o.d"
+  "CMakeFiles/teste_captura.dir/root/repo/lib/captura_audio.c.o"
+  "CMakeFiles/teste_captura.dir/root/repo/lib/captura_audio.c.o.d"
+  "CMakeFiles/teste_captura.dir/testes/pico_falso/pico_falso.c.o"
+  "CMakeFiles/teste_captura.dir/testes/pico_falso/pico_falso.c.o.d"
+  "CMakeFiles/teste_captura.dir/testes/teste_captura.c.o"
+  "CMakeFiles/teste_captura.dir/testes/teste_captura.c.o.d"
+  "teste_captura"
+  "teste_captura.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_captura.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
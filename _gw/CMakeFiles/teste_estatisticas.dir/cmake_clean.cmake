@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_estatisticas.dir/root/repo/lib/estatisticas.c.o"
+  "CMakeFiles/teste_estatisticas.dir/root/repo/lib/estatisticas.c.o.d"
+  "CMakeFiles/teste_estatisticas.dir/testes/teste_estatisticas.c.o"
+  "CMakeFiles/teste_estatisticas.dir/testes/teste_estatisticas.c.o.d"
+  "teste_estatisticas"
+  "teste_estatisticas.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_estatisticas.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/lib/servidor_http.c" "CMakeFiles/teste_servidor_http.dir/root/repo/lib/servidor_http.c.o" "gcc" "CMakeFiles/teste_servidor_http.dir/root/repo/lib/servidor_http.c.o.d"
+  "/root/repo/host/testes/lwip_falso/lwip_falso.c" "CMakeFiles/teste_servidor_http.dir/testes/lwip_falso/lwip_falso.c.o" "gcc" "CMakeFiles/teste_servidor_http.dir/testes/lwip_falso/lwip_falso.c.o.d"
+  "/root/repo/host/testes/teste_servidor_http.c" "CMakeFiles/teste_servidor_http.dir/testes/teste_servidor_http.c.o" "gcc" "CMakeFiles/teste_servidor_http.dir/testes/teste_servidor_http.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_servidor_http.dir/root/repo/lib/servidor_http.c.o"
+  "CMakeFiles/teste_servidor_http.dir/root/repo/lib/servidor_http.c.o.d"
+  "CMakeFiles/teste_servidor_http.dir/testes/lwip_falso/lwip_falso.c.o"
+  "CMakeFiles/teste_servidor_http.dir/testes/lwip_falso/lwip_falso.c.o.d"
+  "CMakeFiles/teste_servidor_http.dir/testes/teste_servidor_http.c.o"
+  "CMakeFiles/teste_servidor_http.dir/testes/teste_servidor_http.c.o.d"
+  "teste_servidor_http"
+  "teste_servidor_http.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_servidor_http.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/teste_ui.dir/root/repo/lib/ui.c.o"
+  "CMakeFiles/teste_ui.dir/root/repo/lib/ui.c.o.d"
+  "CMakeFiles/teste_ui.dir/testes/teste_ui.c.o"
+  "CMakeFiles/teste_ui.dir/testes/teste_ui.c.o.d"
+  "teste_ui"
+  "teste_ui.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/teste_ui.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
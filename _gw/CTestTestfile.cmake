@@ -0,0 +1,28 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/host
+# Build directory: /root/repo/_gw
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(estatisticas "/root/repo/_gw/teste_estatisticas")
+set_tests_properties(estatisticas PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;79;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(adpcm "/root/repo/_gw/teste_adpcm")
+set_tests_properties(adpcm PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;93;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(captura "/root/repo/_gw/teste_captura")
+set_tests_properties(captura PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;108;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(agendador "/root/repo/_gw/teste_agendador")
+set_tests_properties(agendador PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;116;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(agregador "/root/repo/_gw/teste_agregador")
+set_tests_properties(agregador PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;125;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(baixo_consumo "/root/repo/_gw/teste_baixo_consumo")
+set_tests_properties(baixo_consumo PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;134;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(ui "/root/repo/_gw/teste_ui")
+set_tests_properties(ui PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;143;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(cancelador "/root/repo/_gw/teste_cancelador")
+set_tests_properties(cancelador PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;152;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(dsp_fundido_x_separado "/root/repo/_gw/bench_dsp" "20000")
+set_tests_properties(dsp_fundido_x_separado PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;155;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(servidor_http "/root/repo/_gw/teste_servidor_http")
+set_tests_properties(servidor_http PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;167;add_test;/root/repo/host/CMakeLists.txt;0;")
+add_test(dashboard "/root/.pyenv/shims/python3" "/root/repo/host/testes/teste_dashboard.py" "/root/repo/host/..")
+set_tests_properties(dashboard PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/host/CMakeLists.txt;172;add_test;/root/repo/host/CMakeLists.txt;0;")
@@ -0,0 +1,263 @@
+#include "agregador.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAMANHO_TABELA (AGREG_MAX_DISPOSITIVOS * 2)
+
+// Hash FNV-1a do identificador
+static uint32_t hash_id(const char *id) {
+    uint32_t h = 2166136261u;
+    while (*id) {
+        h ^= (uint8_t)*id++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int classe_do_nivel(float db) {
+    int classe = (int)db;
+    if (classe < 0) classe = 0;
+    if (classe >= AGREG_CLASSES_DB) classe = AGREG_CLASSES_DB - 1;
+    return classe;
+}
+
+static float energia_para_db(double energia) {
+    return energia > 0.0 ? (float)(10.0 * log10(energia)) : 0.0f;
+}
+
+bool agregador_iniciar(agregador_t *ag, uint32_t intervalo_s) {
+    memset(ag, 0, sizeof(*ag));
+    ag->intervalo_s = intervalo_s > 0 ? intervalo_s : 1;
+    ag->dispositivos = calloc(AGREG_MAX_DISPOSITIVOS, sizeof(agreg_dispositivo_t));
+    if (!ag->dispositivos) return false;
+    for (int i = 0; i < TAMANHO_TABELA; i++) ag->tabela[i] = -1;
+    return true;
+}
+
+void agregador_liberar(agregador_t *ag) {
+    free(ag->dispositivos);
+    ag->dispositivos = NULL;
+    ag->num_dispositivos = 0;
+}
+
+int agregador_buscar(const agregador_t *ag, const char *id) {
+    uint32_t pos = hash_id(id) % TAMANHO_TABELA;
+    while (ag->tabela[pos] >= 0) {
+        if (strcmp(ag->dispositivos[ag->tabela[pos]].id, id) == 0) return ag->tabela[pos];
+        pos = (pos + 1) % TAMANHO_TABELA;
+    }
+    return -1;
+}
+
+int agregador_buscar_zona(const agregador_t *ag, const char *zona) {
+    for (int i = 0; i < ag->num_zonas; i++) {
+        if (strcmp(ag->zonas[i], zona) == 0) return i;
+    }
+    return -1;
+}
+
+static int obter_zona(agregador_t *ag, const char *zona) {
+    int indice = agregador_buscar_zona(ag, zona);
+    if (indice >= 0 || ag->num_zonas >= AGREG_MAX_ZONAS) return indice;
+    snprintf(ag->zonas[ag->num_zonas], TELEMETRIA_TAMANHO_ID, "%s", zona);
+    return ag->num_zonas++;
+}
+
+static int obter_dispositivo(agregador_t *ag, const char *id, int64_t indice_atual) {
+    uint32_t pos = hash_id(id) % TAMANHO_TABELA;
+    while (ag->tabela[pos] >= 0) {
+        if (strcmp(ag->dispositivos[ag->tabela[pos]].id, id) == 0) return ag->tabela[pos];
+        pos = (pos + 1) % TAMANHO_TABELA;
+    }
+    if (ag->num_dispositivos >= AGREG_MAX_DISPOSITIVOS) return -1;
+
+    int indice = ag->num_dispositivos++;
+    agreg_dispositivo_t *d = &ag->dispositivos[indice];
+    snprintf(d->id, sizeof(d->id), "%s", id);
+    d->zona = -1;
+    d->indice_atual = indice_atual;
+    ag->tabela[pos] = indice;
+    return indice;
+}
+
+// Fecha o intervalo em andamento (e os vazios seguintes) até chegar a "indice",
+// retirando da janela os intervalos que saem do anel
+static void fechar_ate(agreg_dispositivo_t *d, int64_t indice) {
+    if (indice - d->indice_atual > AGREG_HISTORICO) {
+        // Lacuna maior que a janela: nada do histórico continua válido
+        memset(d->anel, 0, sizeof(d->anel));
+        memset(d->histograma, 0, sizeof(d->histograma));
+        d->energia_janela = 0.0;
+        d->intervalos_com_dados = 0;
+        d->indice_atual = indice;
+        d->energia_atual = 0.0;
+        d->max_atual = 0.0f;
+        d->leituras_atual = 0;
+        return;
+    }
+
+    while (d->indice_atual < indice) {
+        agreg_intervalo_t *slot = &d->anel[d->indice_atual % AGREG_HISTORICO];
+
+        if (slot->leituras > 0) {
+            d->energia_janela -= slot->energia;
+            d->histograma[classe_do_nivel(energia_para_db(slot->energia))]--;
+            d->intervalos_com_dados--;
+        }
+
+        slot->leituras = d->leituras_atual;
+        if (d->leituras_atual > 0) {
+            slot->energia = (float)(d->energia_atual / d->leituras_atual);
+            slot->max_ddb = (int16_t)lrintf(d->max_atual * 10.0f);
+            d->energia_janela += slot->energia;
+            d->histograma[classe_do_nivel(energia_para_db(slot->energia))]++;
+            d->intervalos_com_dados++;
+        }
+
+        d->indice_atual++;
+        d->energia_atual = 0.0;
+        d->max_atual = 0.0f;
+        d->leituras_atual = 0;
+    }
+}
+
+// Soma uma leitura enviada em lote a um intervalo já fechado que ainda está na janela
+static void acumular_fechado(agreg_dispositivo_t *d, int64_t indice, double energia, float maximo) {
+    agreg_intervalo_t *slot = &d->anel[indice % AGREG_HISTORICO];
+    int16_t max_ddb = (int16_t)lrintf(maximo * 10.0f);
+
+    if (slot->leituras > 0) {
+        d->energia_janela -= slot->energia;
+        d->histograma[classe_do_nivel(energia_para_db(slot->energia))]--;
+        slot->energia = (float)((slot->energia * (double)slot->leituras + energia) / (slot->leituras + 1));
+        if (max_ddb > slot->max_ddb) slot->max_ddb = max_ddb;
+    } else {
+        d->intervalos_com_dados++;
+        slot->energia = (float)energia;
+        slot->max_ddb = max_ddb;
+    }
+    if (slot->leituras < UINT16_MAX) slot->leituras++;
+    d->energia_janela += slot->energia;
+    d->histograma[classe_do_nivel(energia_para_db(slot->energia))]++;
+}
+
+// Processa um datagrama de telemetria recebido no instante agora_s (relógio do coletor)
+bool agregador_ingerir(agregador_t *ag, const char *mensagem, size_t tamanho, double agora_s) {
+    char texto[TELEMETRIA_TAMANHO_MAX + 1];
+    char id[TELEMETRIA_TAMANHO_ID];
+    char zona[TELEMETRIA_TAMANHO_ID];
+    unsigned long sequencia;
+    unsigned long idade_s = 0;
+    float leq, maximo;
+
+    ag->datagramas++;
+    if (tamanho > TELEMETRIA_TAMANHO_MAX) tamanho = TELEMETRIA_TAMANHO_MAX;
+    memcpy(texto, mensagem, tamanho);
+    texto[tamanho] = '\0';
+    if (sscanf(texto, TELEMETRIA_FORMATO_LER, id, zona, &sequencia, &leq, &maximo, &idade_s) < 5) {
+        ag->invalidos++;
+        return false;
+    }
+
+    int64_t indice = (int64_t)(agora_s / ag->intervalo_s);
+    int i = obter_dispositivo(ag, id, indice);
+    if (i < 0) {
+        ag->descartados++;
+        return false;
+    }
+
+    agreg_dispositivo_t *d = &ag->dispositivos[i];
+    d->zona = obter_zona(ag, zona);
+    fechar_ate(d, indice);
+
+    // Leituras em lote vão para o intervalo em que foram medidas
+    int64_t indice_leitura = (int64_t)((agora_s - (double)idade_s) / ag->intervalo_s);
+    if (indice_leitura < d->indice_atual) {
+        if (indice_leitura > d->indice_atual - AGREG_HISTORICO) {
+            acumular_fechado(d, indice_leitura, pow(10.0, leq / 10.0), maximo);
+            ag->atrasadas++;
+        } else {
+            ag->descartados++;
+        }
+    } else {
+        d->energia_atual += pow(10.0, leq / 10.0);
+        if (d->leituras_atual == 0 || maximo > d->max_atual) d->max_atual = maximo;
+        if (d->leituras_atual < UINT16_MAX) d->leituras_atual++;
+    }
+
+    if (d->recebidas > 0 && sequencia > d->ultima_sequencia + 1) {
+        d->perdidas += sequencia - d->ultima_sequencia - 1;
+    }
+    d->ultima_sequencia = (uint32_t)sequencia;
+    d->recebidas++;
+    return true;
+}
+
+// Faz a janela de todos os dispositivos andar, inclusive dos que pararam de enviar
+void agregador_avancar(agregador_t *ag, double agora_s) {
+    int64_t indice = (int64_t)(agora_s / ag->intervalo_s);
+    for (int i = 0; i < ag->num_dispositivos; i++) {
+        if (ag->dispositivos[i].indice_atual < indice) fechar_ate(&ag->dispositivos[i], indice);
+    }
+}
+
+// Ln a partir do histograma de 1 dB (centro da classe)
+static float nivel_excedido(const uint32_t *histograma, uint32_t total, float percentual) {
+    if (total == 0) return 0.0f;
+    uint32_t posicao = (uint32_t)ceil((100.0 - percentual) / 100.0 * total);
+    if (posicao < 1) posicao = 1;
+    uint32_t acumulado = 0;
+    for (int i = 0; i < AGREG_CLASSES_DB; i++) {
+        acumulado += histograma[i];
+        if (acumulado >= posicao) return i + 0.5f;
+    }
+    return AGREG_CLASSES_DB - 0.5f;
+}
+
+static void acumular_resumo(const agreg_dispositivo_t *d, double *energia, uint32_t *intervalos,
+                            float *maximo, uint32_t *histograma) {
+    *energia += d->energia_janela;
+    *intervalos += d->intervalos_com_dados;
+    for (int i = 0; i < AGREG_CLASSES_DB; i++) histograma[i] += d->histograma[i];
+    for (int i = 0; i < AGREG_HISTORICO; i++) {
+        const agreg_intervalo_t *slot = &d->anel[i];
+        if (slot->leituras > 0 && slot->max_ddb / 10.0f > *maximo) *maximo = slot->max_ddb / 10.0f;
+    }
+}
+
+static void finalizar_resumo(double energia, uint32_t intervalos, float maximo,
+                             const uint32_t *histograma, agreg_resumo_t *resumo) {
+    resumo->intervalos = intervalos;
+    resumo->leq = intervalos ? energia_para_db(energia / intervalos) : 0.0f;
+    resumo->maximo = maximo;
+    resumo->l10 = nivel_excedido(histograma, intervalos, 10.0f);
+    resumo->l50 = nivel_excedido(histograma, intervalos, 50.0f);
+    resumo->l90 = nivel_excedido(histograma, intervalos, 90.0f);
+}
+
+void agregador_resumo_dispositivo(const agregador_t *ag, int indice, agreg_resumo_t *resumo) {
+    double energia = 0.0;
+    uint32_t intervalos = 0;
+    float maximo = 0.0f;
+    uint32_t histograma[AGREG_CLASSES_DB] = {0};
+
+    acumular_resumo(&ag->dispositivos[indice], &energia, &intervalos, &maximo, histograma);
+    finalizar_resumo(energia, intervalos, maximo, histograma, resumo);
+}
+
+// Zona: energia média de todos os intervalos dos seus dispositivos e histogramas somados
+void agregador_resumo_zona(const agregador_t *ag, int zona, agreg_resumo_t *resumo) {
+    double energia = 0.0;
+    uint32_t intervalos = 0;
+    float maximo = 0.0f;
+    uint32_t histograma[AGREG_CLASSES_DB] = {0};
+
+    for (int i = 0; i < ag->num_dispositivos; i++) {
+        if (ag->dispositivos[i].zona == zona) {
+            acumular_resumo(&ag->dispositivos[i], &energia, &intervalos, &maximo, histograma);
+        }
+    }
+    finalizar_resumo(energia, intervalos, maximo, histograma, resumo);
+}
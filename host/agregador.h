@@ -0,0 +1,75 @@
+#ifndef AGREGADOR_H
+#define AGREGADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "telemetria.h"
+
+// Agregação das leituras de vários monitores em intervalos fixos, alinhados pelo relógio do
+// coletor. Cada dispositivo guarda uma janela móvel de AGREG_HISTORICO intervalos em anel.
+#define AGREG_MAX_DISPOSITIVOS 4096
+#define AGREG_MAX_ZONAS        256
+#define AGREG_HISTORICO        360     // Ex.: 1 hora com intervalos de 10 s
+#define AGREG_CLASSES_DB       150     // Histograma de 1 dB para os percentis da janela (o fundo de escala do medidor é ~141 dB)
+
+// Um intervalo fechado: energia média (Leq linear), máximo em décimos de dB e número de leituras
+typedef struct {
+    float energia;
+    int16_t max_ddb;
+    uint16_t leituras;
+} agreg_intervalo_t;
+
+typedef struct {
+    char id[TELEMETRIA_TAMANHO_ID];
+    int zona;
+
+    // Intervalo em andamento
+    int64_t indice_atual;
+    double energia_atual;
+    float max_atual;
+    uint16_t leituras_atual;
+
+    // Janela móvel: a posição i % AGREG_HISTORICO guarda o intervalo i
+    agreg_intervalo_t anel[AGREG_HISTORICO];
+    double energia_janela;                 // Soma das energias dos intervalos com leituras
+    uint32_t intervalos_com_dados;
+    uint16_t histograma[AGREG_CLASSES_DB];
+
+    uint32_t ultima_sequencia;
+    uint64_t perdidas;                     // Lacunas na sequência do dispositivo
+    uint64_t recebidas;
+} agreg_dispositivo_t;
+
+// Resumo da janela móvel de um dispositivo ou zona
+typedef struct {
+    float leq;
+    float maximo;
+    float l10, l50, l90;
+    uint32_t intervalos;
+} agreg_resumo_t;
+
+typedef struct {
+    uint32_t intervalo_s;
+    agreg_dispositivo_t *dispositivos;     // Alocado uma vez em agregador_iniciar()
+    int num_dispositivos;
+    int32_t tabela[AGREG_MAX_DISPOSITIVOS * 2]; // Hash id -> índice (-1 = vazio)
+    char zonas[AGREG_MAX_ZONAS][TELEMETRIA_TAMANHO_ID];
+    int num_zonas;
+
+    uint64_t datagramas;
+    uint64_t invalidos;
+    uint64_t descartados;                  // Sem espaço para novos dispositivos ou mais antigas que a janela
+    uint64_t atrasadas;                    // Leituras em lote colocadas em intervalos já fechados
+} agregador_t;
+
+bool agregador_iniciar(agregador_t *ag, uint32_t intervalo_s);
+void agregador_liberar(agregador_t *ag);
+bool agregador_ingerir(agregador_t *ag, const char *mensagem, size_t tamanho, double agora_s);
+void agregador_avancar(agregador_t *ag, double agora_s);
+int agregador_buscar(const agregador_t *ag, const char *id);
+int agregador_buscar_zona(const agregador_t *ag, const char *zona);
+void agregador_resumo_dispositivo(const agregador_t *ag, int indice, agreg_resumo_t *resumo);
+void agregador_resumo_zona(const agregador_t *ag, int zona, agreg_resumo_t *resumo);
+
+#endif // AGREGADOR_H
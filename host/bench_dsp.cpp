@@ -0,0 +1,128 @@
+/*
+ * Descrição: Benchmark de lib/dsp_pipeline.hpp no host. Os mesmos estágios da medição de nível
+ *            (lib/dsp_medicao.hpp: DC, cancelamento do buzzer, banda, decimação, RMS, dB)
+ *            processam o mesmo sinal de duas formas: fundidos em um único laço por bloco
+ *            (dsp::Pipeline) e em passadas separadas por estágio, com um buffer intermediário
+ *            como na cadeia antiga em C. O buzzer está tocando e o cancelamento ligado, como
+ *            durante um alarme. Confere que os dois dão o mesmo resultado e informa o tempo
+ *            por bloco.
+ *
+ * Uso: bench_dsp [blocos]
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "dsp_medicao.hpp"
+
+namespace {
+
+using namespace medicao;
+
+constexpr std::size_t N = DSP_AMOSTRAS_BLOCO;
+
+using Fundido = Cadeia;
+
+// Os mesmos estágios aplicados um de cada vez ao bloco inteiro
+class Separado {
+public:
+    Buzzer &buzzer() { return buzzer_; }
+
+    float processar(const std::uint16_t *entrada) {
+        float buffer[N];
+        for (std::size_t i = 0; i < N; i++) buffer[i] = static_cast<float>(entrada[i]);
+        for (std::size_t i = 0; i < N; i++) dc_.passo(buffer[i]);
+        for (std::size_t i = 0; i < N; i++) buzzer_.passo(buffer[i]);
+        for (std::size_t i = 0; i < N; i++) banda_.passo(buffer[i]);
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < N; i++) {
+            if (decimacao_.passo(buffer[i])) buffer[n++] = buffer[i];
+        }
+        for (std::size_t i = 0; i < n; i++) rms_.passo(buffer[i]);
+
+        float resultado = 0.0f;
+        dc_.fim_bloco(resultado);
+        buzzer_.fim_bloco(resultado);
+        banda_.fim_bloco(resultado);
+        decimacao_.fim_bloco(resultado);
+        rms_.fim_bloco(resultado);
+        db_.fim_bloco(resultado);
+        return resultado;
+    }
+
+private:
+    DC dc_;
+    Buzzer buzzer_;
+    Banda banda_;
+    Decimacao decimacao_;
+    RMS rms_;
+    DB db_;
+};
+
+// Microfone sintético: offset do ADC, tom de 440 Hz, ruído e a onda quadrada de 90% do
+// buzzer, em 12 bits
+std::vector<std::uint16_t> gerar_sinal(std::size_t amostras) {
+    std::vector<std::uint16_t> sinal(amostras);
+    std::uint32_t semente = 1;
+    for (std::size_t i = 0; i < amostras; i++) {
+        semente = semente * 1664525u + 1013904223u;
+        double ruido = ((semente >> 8) / 16777216.0 - 0.5) * 200.0;
+        double fase_buzzer = i * DSP_BUZZER_FREQUENCIA_HZ / DSP_TAXA_HZ;
+        double buzzer = fase_buzzer - std::floor(fase_buzzer) < 0.9 ? 60.0 : -540.0;
+        double v = 2048.0 + 300.0 * std::sin(2.0 * 3.14159265358979 * 440.0 * i / DSP_TAXA_HZ) + ruido + buzzer;
+        sinal[i] = static_cast<std::uint16_t>(v < 0.0 ? 0.0 : (v > 4095.0 ? 4095.0 : v));
+    }
+    return sinal;
+}
+
+template <typename Cadeia>
+double medir_ns_por_bloco(Cadeia &cadeia, const std::vector<std::uint16_t> &sinal, std::size_t blocos,
+                          std::vector<float> &saida) {
+    auto inicio = std::chrono::steady_clock::now();
+    for (std::size_t b = 0; b < blocos; b++) {
+        saida[b] = cadeia.processar(&sinal[b * N]);
+    }
+    auto fim = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(fim - inicio).count() / blocos;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::size_t blocos = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    if (blocos == 0) blocos = 1;
+
+    auto sinal = gerar_sinal(blocos * N);
+    std::vector<float> saida_fundido(blocos), saida_separado(blocos);
+
+    // Uma rodada de aquecimento de cada antes da medição
+    {
+        Fundido f;
+        Separado s;
+        f.estagio<ESTAGIO_BUZZER>().ativar(true);
+        s.buzzer().ativar(true);
+        medir_ns_por_bloco(f, sinal, blocos, saida_fundido);
+        medir_ns_por_bloco(s, sinal, blocos, saida_separado);
+    }
+    Fundido fundido;
+    Separado separado;
+    fundido.estagio<ESTAGIO_BUZZER>().ativar(true);
+    separado.buzzer().ativar(true);
+    double ns_fundido = medir_ns_por_bloco(fundido, sinal, blocos, saida_fundido);
+    double ns_separado = medir_ns_por_bloco(separado, sinal, blocos, saida_separado);
+
+    std::size_t diferentes = 0;
+    for (std::size_t b = 0; b < blocos; b++) {
+        if (saida_fundido[b] != saida_separado[b]) diferentes++;
+    }
+
+    std::printf("Blocos de %zu amostras: %zu (%.1f s de áudio)\n", N, blocos, blocos * N / 8000.0);
+    std::printf("Fundido:  %8.1f ns/bloco\n", ns_fundido);
+    std::printf("Separado: %8.1f ns/bloco (%.2fx o fundido)\n", ns_separado, ns_separado / ns_fundido);
+    std::printf("Último nível: %.2f dB SPL | rejeição do buzzer: %.1f dB | blocos com resultado diferente: %zu\n",
+                saida_fundido[blocos - 1], fundido.estagio<ESTAGIO_BUZZER>().rejeicao_db(), diferentes);
+    return diferentes ? 1 : 0;
+}
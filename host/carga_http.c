@@ -0,0 +1,305 @@
+/*
+ * Descrição: Gerador de carga para o servidor HTTP do monitor (lib/servidor_http.c).
+ *            Mantém C clientes simultâneos fazendo GET em sequência, com ou sem keep-alive,
+ *            e mede requisições/s e latência. Ao final consulta GET /servidor e compara o
+ *            número de conexões ativas com o esperado, para detectar vazamentos em testes longos.
+ *
+ * Uso: carga_http [-c clientes] [-d duracao_s] [-k] [-h host] [-p porta] [-r caminho]
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RESPOSTA_MAX     4096
+#define LATENCIA_CLASSES 2000   // Histograma de 1 ms por classe; a última acumula o excesso
+#define TIMEOUT_S        5.0
+
+typedef enum { DESCONECTADO, CONECTANDO, ENVIANDO, RECEBENDO } estado_cliente_t;
+
+typedef struct {
+    int fd;
+    estado_cliente_t estado;
+    char resposta[RESPOSTA_MAX];
+    size_t recebido;
+    size_t enviado;
+    long corpo_esperado;        // -1 enquanto o cabeçalho não chegou
+    size_t inicio_corpo;
+    size_t corpo_recebido;
+    bool servidor_fecha;        // Resposta com "Connection: close"
+    double inicio;
+} cliente_t;
+
+static struct sockaddr_in destino;
+static char requisicao[256];
+static size_t tamanho_requisicao;
+static bool keep_alive = false;
+
+static unsigned long long latencias[LATENCIA_CLASSES];
+static unsigned long long concluidas, falhas, conexoes;
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void desconectar(cliente_t *c) {
+    if (c->fd >= 0) close(c->fd);
+    c->fd = -1;
+    c->estado = DESCONECTADO;
+}
+
+static void nova_requisicao(cliente_t *c) {
+    c->estado = ENVIANDO;
+    c->enviado = 0;
+    c->recebido = 0;
+    c->corpo_esperado = -1;
+    c->corpo_recebido = 0;
+    c->servidor_fecha = false;
+    c->inicio = agora();
+}
+
+static void conectar(cliente_t *c) {
+    c->fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (c->fd < 0) {
+        falhas++;
+        return;
+    }
+    fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_NONBLOCK);
+    nova_requisicao(c);
+    conexoes++;
+    if (connect(c->fd, (struct sockaddr *)&destino, sizeof(destino)) < 0) {
+        if (errno != EINPROGRESS) {
+            falhas++;
+            desconectar(c);
+            return;
+        }
+        c->estado = CONECTANDO;
+    }
+}
+
+static void registrar_latencia(double segundos) {
+    long classe = (long)(segundos * 1000.0);
+    if (classe >= LATENCIA_CLASSES) classe = LATENCIA_CLASSES - 1;
+    latencias[classe]++;
+    concluidas++;
+}
+
+// Procura Content-Length e Connection no cabeçalho recebido; retorna false enquanto ele não estiver completo
+static bool ler_cabecalho(cliente_t *c) {
+    c->resposta[c->recebido < RESPOSTA_MAX ? c->recebido : RESPOSTA_MAX - 1] = '\0';
+    char *fim = strstr(c->resposta, "\r\n\r\n");
+    if (!fim) return false;
+    c->inicio_corpo = (size_t)(fim + 4 - c->resposta);
+    c->corpo_esperado = 0;
+    for (char *linha = strstr(c->resposta, "\r\n"); linha && linha < fim; linha = strstr(linha + 2, "\r\n")) {
+        if (strncasecmp(linha + 2, "Content-Length:", 15) == 0) {
+            c->corpo_esperado = atol(linha + 17);
+        } else if (strncasecmp(linha + 2, "Connection: close", 17) == 0) {
+            c->servidor_fecha = true;
+        }
+    }
+    c->corpo_recebido = c->recebido - c->inicio_corpo;
+    // O corpo não é guardado; só contamos os bytes
+    c->recebido = c->inicio_corpo;
+    return true;
+}
+
+static void tratar_evento(cliente_t *c, short eventos) {
+    if (c->estado == CONECTANDO) {
+        int erro = 0;
+        socklen_t tamanho = sizeof(erro);
+        getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &erro, &tamanho);
+        if (erro) {
+            falhas++;
+            desconectar(c);
+            return;
+        }
+        c->estado = ENVIANDO;
+    }
+    if (c->estado == ENVIANDO && (eventos & POLLOUT)) {
+        ssize_t n = send(c->fd, requisicao + c->enviado, tamanho_requisicao - c->enviado, MSG_NOSIGNAL);
+        if (n < 0 && errno != EAGAIN) {
+            falhas++;
+            desconectar(c);
+            return;
+        }
+        if (n > 0) c->enviado += (size_t)n;
+        if (c->enviado == tamanho_requisicao) c->estado = RECEBENDO;
+        return;
+    }
+    if (c->estado == RECEBENDO && (eventos & (POLLIN | POLLHUP | POLLERR))) {
+        char descarte[RESPOSTA_MAX];
+        char *destino_leitura = c->corpo_esperado < 0 ? c->resposta + c->recebido : descarte;
+        size_t espaco = c->corpo_esperado < 0 ? RESPOSTA_MAX - 1 - c->recebido : sizeof(descarte);
+        ssize_t n = recv(c->fd, destino_leitura, espaco, 0);
+        if (n < 0 && errno == EAGAIN) return;
+        if (n <= 0) {
+            // Conexão encerrada (ou recusada pelo pool cheio) antes do fim da resposta
+            falhas++;
+            desconectar(c);
+            return;
+        }
+        if (c->corpo_esperado < 0) {
+            c->recebido += (size_t)n;
+            if (!ler_cabecalho(c)) {
+                if (c->recebido >= RESPOSTA_MAX - 1) {
+                    falhas++;
+                    desconectar(c);
+                }
+                return;
+            }
+        } else {
+            c->corpo_recebido += (size_t)n;
+        }
+        if ((long)c->corpo_recebido >= c->corpo_esperado) {
+            registrar_latencia(agora() - c->inicio);
+            if (keep_alive && !c->servidor_fecha) nova_requisicao(c);
+            else desconectar(c);
+        }
+    }
+}
+
+static double percentil(double p) {
+    unsigned long long alvo = (unsigned long long)(p / 100.0 * concluidas);
+    unsigned long long acumulado = 0;
+    for (int i = 0; i < LATENCIA_CLASSES; i++) {
+        acumulado += latencias[i];
+        if (acumulado > alvo) return i + 0.5;
+    }
+    return LATENCIA_CLASSES;
+}
+
+// Consulta GET /servidor numa conexão própria e imprime o estado do pool
+static void verificar_servidor(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&destino, sizeof(destino)) < 0) {
+        printf("Não foi possível consultar /servidor\n");
+        if (fd >= 0) close(fd);
+        return;
+    }
+    const char *consulta = "GET /servidor HTTP/1.1\r\nHost: monitor\r\nConnection: close\r\n\r\n";
+    send(fd, consulta, strlen(consulta), MSG_NOSIGNAL);
+    char resposta[RESPOSTA_MAX];
+    size_t recebido = 0;
+    ssize_t n;
+    while (recebido < sizeof(resposta) - 1 && (n = recv(fd, resposta + recebido, sizeof(resposta) - 1 - recebido, 0)) > 0) {
+        recebido += (size_t)n;
+    }
+    resposta[recebido] = '\0';
+    close(fd);
+
+    char *corpo = strstr(resposta, "\r\n\r\n");
+    char *ativas = corpo ? strstr(corpo, "\"ativas\":") : NULL;
+    if (!ativas) {
+        printf("Resposta inesperada de /servidor\n");
+        return;
+    }
+    printf("Servidor: %s\n", corpo + 4);
+    // A própria consulta ocupa uma entrada do pool
+    long abertas = atol(ativas + strlen("\"ativas\":"));
+    if (abertas > 1) printf("ATENÇÃO: %ld conexões ainda ativas após o teste (possível vazamento)\n", abertas - 1);
+    else printf("Nenhuma conexão presa no servidor\n");
+}
+
+int main(int argc, char **argv) {
+    int num_clientes = 4;
+    double duracao = 30.0;
+    const char *host = "127.0.0.1";
+    uint16_t porta = 80;
+    const char *caminho = "/dados";
+
+    int opcao;
+    while ((opcao = getopt(argc, argv, "c:d:kh:p:r:")) != -1) {
+        switch (opcao) {
+        case 'c': num_clientes = atoi(optarg); break;
+        case 'd': duracao = atof(optarg); break;
+        case 'k': keep_alive = true; break;
+        case 'h': host = optarg; break;
+        case 'p': porta = (uint16_t)atoi(optarg); break;
+        case 'r': caminho = optarg; break;
+        default:
+            fprintf(stderr, "Uso: %s [-c clientes] [-d duracao_s] [-k] [-h host] [-p porta] [-r caminho]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (num_clientes < 1 || duracao <= 0.0) {
+        fprintf(stderr, "Parâmetros inválidos\n");
+        return 1;
+    }
+
+    destino.sin_family = AF_INET;
+    destino.sin_port = htons(porta);
+    if (inet_pton(AF_INET, host, &destino.sin_addr) != 1) {
+        fprintf(stderr, "Destino inválido: %s\n", host);
+        return 1;
+    }
+    tamanho_requisicao = (size_t)snprintf(requisicao, sizeof(requisicao),
+                                          "GET %s HTTP/1.1\r\nHost: monitor\r\nConnection: %s\r\n\r\n",
+                                          caminho, keep_alive ? "keep-alive" : "close");
+
+    cliente_t *clientes = calloc(num_clientes, sizeof(cliente_t));
+    struct pollfd *fds = calloc(num_clientes, sizeof(struct pollfd));
+    if (!clientes || !fds) return 1;
+    for (int i = 0; i < num_clientes; i++) clientes[i].fd = -1;
+
+    printf("%d clientes, %s, GET %s em %s:%u por %.0f s\n", num_clientes,
+           keep_alive ? "keep-alive" : "uma conexão por requisição", caminho, host, porta, duracao);
+
+    double inicio = agora();
+    double ultimo_relatorio = inicio;
+    unsigned long long concluidas_relatorio = 0;
+    while (agora() - inicio < duracao) {
+        for (int i = 0; i < num_clientes; i++) {
+            cliente_t *c = &clientes[i];
+            if (c->estado == DESCONECTADO) conectar(c);
+            if (c->estado != DESCONECTADO && agora() - c->inicio > TIMEOUT_S) {
+                falhas++;
+                desconectar(c);
+            }
+            fds[i].fd = c->fd;
+            fds[i].events = (c->estado == CONECTANDO || c->estado == ENVIANDO) ? POLLOUT : POLLIN;
+            fds[i].revents = 0;
+        }
+        if (poll(fds, num_clientes, 100) < 0 && errno != EINTR) break;
+        for (int i = 0; i < num_clientes; i++) {
+            if (fds[i].fd >= 0 && fds[i].revents) tratar_evento(&clientes[i], fds[i].revents);
+        }
+
+        double t = agora();
+        if (t - ultimo_relatorio >= 5.0) {
+            printf("  %.0f s: %.1f req/s | concluídas %llu | falhas %llu\n", t - inicio,
+                   (concluidas - concluidas_relatorio) / (t - ultimo_relatorio), concluidas, falhas);
+            ultimo_relatorio = t;
+            concluidas_relatorio = concluidas;
+        }
+    }
+    double decorrido = agora() - inicio;
+    for (int i = 0; i < num_clientes; i++) desconectar(&clientes[i]);
+
+    printf("Concluídas: %llu (%.1f req/s) | falhas: %llu | conexões abertas: %llu\n",
+           concluidas, concluidas / decorrido, falhas, conexoes);
+    if (concluidas > 0) {
+        printf("Latência (ms): p50 %.1f | p90 %.1f | p99 %.1f\n", percentil(50), percentil(90), percentil(99));
+    }
+
+    // Dá tempo para o servidor processar os FINs antes de conferir o pool
+    sleep(2);
+    verificar_servidor();
+
+    free(clientes);
+    free(fds);
+    return 0;
+}
@@ -0,0 +1,264 @@
+/*
+ * Descrição: Coletor de telemetria para frotas de monitores de ruído (Linux).
+ *            Recebe os datagramas UDP das placas (lib/telemetria.c), alinha as leituras em
+ *            intervalos fixos e mantém agregados por dispositivo e por zona em memória.
+ *            As consultas são feitas por uma API HTTP local que responde JSON:
+ *              GET /dispositivos        GET /dispositivo/<id>
+ *              GET /zonas               GET /zona/<nome>
+ *              GET /estatisticas
+ *
+ * Uso: coletor [-u porta_udp] [-p porta_http] [-i intervalo_s]
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "agregador.h"
+
+#define RESPOSTA_MAX (256 * 1024)
+#define ID_JSON_MAX  (TELEMETRIA_TAMANHO_ID * 6)   // Pior caso: todo caractere vira \u00XX
+
+static agregador_t agregador;
+static volatile sig_atomic_t executando = 1;
+static double inicio_s;
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void parar(int sinal) {
+    (void)sinal;
+    executando = 0;
+}
+
+static int abrir_socket(int tipo, uint16_t porta, const char *endereco) {
+    int fd = socket(AF_INET, tipo, 0);
+    if (fd < 0) return -1;
+
+    int sim = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &sim, sizeof(sim));
+    if (tipo == SOCK_DGRAM) {
+        int buffer = 8 * 1024 * 1024; // Absorve rajadas de centenas de dispositivos
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+    }
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(porta);
+    inet_pton(AF_INET, endereco, &addr.sin_addr);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        (tipo == SOCK_STREAM && listen(fd, 16) < 0)) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+// Lê todos os datagramas pendentes
+static void receber_telemetria(int fd) {
+    char buffer[TELEMETRIA_TAMANHO_MAX + 1];
+    double instante = agora();
+    while (true) {
+        ssize_t n = recv(fd, buffer, sizeof(buffer) - 1, 0);
+        if (n < 0) break;
+        agregador_ingerir(&agregador, buffer, (size_t)n, instante);
+    }
+}
+
+// Ids e zonas vêm da rede e podem conter aspas, barras ou caracteres de controle: escapa para
+// caberem numa string JSON
+static const char *escapar_json(const char *texto, char *destino) {
+    char *p = destino;
+    for (; *texto; texto++) {
+        unsigned char c = (unsigned char)*texto;
+        if (c == '"' || c == '\\') {
+            *p++ = '\\';
+            *p++ = (char)c;
+        } else if (c < 0x20) {
+            p += sprintf(p, "\\u%04x", c);
+        } else {
+            *p++ = (char)c;
+        }
+    }
+    *p = '\0';
+    return destino;
+}
+
+static int escrever_resumo(char *saida, size_t tamanho, const agreg_resumo_t *r) {
+    return snprintf(saida, tamanho,
+                    "\"leq\":%.1f,\"max\":%.1f,\"l10\":%.1f,\"l50\":%.1f,\"l90\":%.1f,\"intervalos\":%u",
+                    r->leq, r->maximo, r->l10, r->l50, r->l90, r->intervalos);
+}
+
+static int json_dispositivo(char *saida, size_t tamanho, int i) {
+    const agreg_dispositivo_t *d = &agregador.dispositivos[i];
+    agreg_resumo_t resumo;
+    agregador_resumo_dispositivo(&agregador, i, &resumo);
+
+    char id[ID_JSON_MAX], zona[ID_JSON_MAX];
+    int n = snprintf(saida, tamanho, "{\"id\":\"%s\",\"zona\":\"%s\",\"recebidas\":%llu,\"perdidas\":%llu,",
+                     escapar_json(d->id, id), escapar_json(d->zona >= 0 ? agregador.zonas[d->zona] : "", zona),
+                     (unsigned long long)d->recebidas, (unsigned long long)d->perdidas);
+    if (n < (int)tamanho) n += escrever_resumo(saida + n, tamanho - n, &resumo);
+    if (n < (int)tamanho) n += snprintf(saida + n, tamanho - n, "}");
+    return n;
+}
+
+static int json_zona(char *saida, size_t tamanho, int z) {
+    agreg_resumo_t resumo;
+    agregador_resumo_zona(&agregador, z, &resumo);
+
+    int dispositivos = 0;
+    for (int i = 0; i < agregador.num_dispositivos; i++) {
+        if (agregador.dispositivos[i].zona == z) dispositivos++;
+    }
+    char zona[ID_JSON_MAX];
+    int n = snprintf(saida, tamanho, "{\"zona\":\"%s\",\"dispositivos\":%d,",
+                     escapar_json(agregador.zonas[z], zona), dispositivos);
+    if (n < (int)tamanho) n += escrever_resumo(saida + n, tamanho - n, &resumo);
+    if (n < (int)tamanho) n += snprintf(saida + n, tamanho - n, "}");
+    return n;
+}
+
+// Monta o corpo JSON da consulta; retorna o status HTTP
+static int responder(const char *caminho, char *corpo, size_t tamanho) {
+    int n = 0;
+    if (strcmp(caminho, "/dispositivos") == 0 || strcmp(caminho, "/zonas") == 0) {
+        bool zonas = caminho[1] == 'z';
+        int total = zonas ? agregador.num_zonas : agregador.num_dispositivos;
+        n = snprintf(corpo, tamanho, "[");
+        for (int i = 0; i < total && n < (int)tamanho; i++) {
+            if (i > 0) n += snprintf(corpo + n, tamanho - n, ",");
+            if (n < (int)tamanho) {
+                n += zonas ? json_zona(corpo + n, tamanho - n, i) : json_dispositivo(corpo + n, tamanho - n, i);
+            }
+        }
+        if (n < (int)tamanho) snprintf(corpo + n, tamanho - n, "]");
+        return 200;
+    }
+    if (strncmp(caminho, "/dispositivo/", 13) == 0) {
+        int i = agregador_buscar(&agregador, caminho + 13);
+        if (i < 0) return 404;
+        json_dispositivo(corpo, tamanho, i);
+        return 200;
+    }
+    if (strncmp(caminho, "/zona/", 6) == 0) {
+        int z = agregador_buscar_zona(&agregador, caminho + 6);
+        if (z < 0) return 404;
+        json_zona(corpo, tamanho, z);
+        return 200;
+    }
+    if (strcmp(caminho, "/estatisticas") == 0) {
+        double decorrido = agora() - inicio_s;
+        snprintf(corpo, tamanho,
+                 "{\"datagramas\":%llu,\"invalidos\":%llu,\"descartados\":%llu,\"atrasadas\":%llu,"
+                 "\"dispositivos\":%d,\"zonas\":%d,\"intervalo_s\":%u,\"datagramas_por_s\":%.1f}",
+                 (unsigned long long)agregador.datagramas, (unsigned long long)agregador.invalidos,
+                 (unsigned long long)agregador.descartados, (unsigned long long)agregador.atrasadas,
+                 agregador.num_dispositivos,
+                 agregador.num_zonas, agregador.intervalo_s,
+                 decorrido > 0 ? agregador.datagramas / decorrido : 0.0);
+        return 200;
+    }
+    return 404;
+}
+
+// Atende uma consulta por conexão (a API é local e as respostas são pequenas)
+static void atender_consulta(int servidor) {
+    static char corpo[RESPOSTA_MAX];
+    int fd = accept(servidor, NULL, NULL);
+    if (fd < 0) return;
+
+    char requisicao[1024];
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    ssize_t n = 0;
+    if (poll(&pfd, 1, 1000) > 0) n = recv(fd, requisicao, sizeof(requisicao) - 1, 0);
+    if (n <= 0) {
+        close(fd);
+        return;
+    }
+    requisicao[n] = '\0';
+
+    char caminho[256] = "";
+    sscanf(requisicao, "GET %255s", caminho);
+    corpo[0] = '\0';
+    int status = responder(caminho, corpo, sizeof(corpo));
+
+    char cabecalho[160];
+    int tamanho_corpo = status == 200 ? (int)strlen(corpo) : 0;
+    int m = snprintf(cabecalho, sizeof(cabecalho),
+                     "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %d\r\nConnection: close\r\n\r\n",
+                     status, status == 200 ? "OK" : "Not Found", tamanho_corpo);
+    send(fd, cabecalho, m, MSG_NOSIGNAL);
+    if (tamanho_corpo > 0) send(fd, corpo, tamanho_corpo, MSG_NOSIGNAL);
+    close(fd);
+}
+
+int main(int argc, char **argv) {
+    uint16_t porta_udp = TELEMETRIA_PORTA;
+    uint16_t porta_http = 8080;
+    uint32_t intervalo_s = 10;
+
+    int opcao;
+    while ((opcao = getopt(argc, argv, "u:p:i:")) != -1) {
+        switch (opcao) {
+        case 'u': porta_udp = (uint16_t)atoi(optarg); break;
+        case 'p': porta_http = (uint16_t)atoi(optarg); break;
+        case 'i': intervalo_s = (uint32_t)atoi(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s [-u porta_udp] [-p porta_http] [-i intervalo_s]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!agregador_iniciar(&agregador, intervalo_s)) {
+        fprintf(stderr, "Sem memória para o agregador\n");
+        return 1;
+    }
+
+    int udp = abrir_socket(SOCK_DGRAM, porta_udp, "0.0.0.0");
+    int http = abrir_socket(SOCK_STREAM, porta_http, "127.0.0.1");
+    if (udp < 0 || http < 0) {
+        perror("Erro ao abrir sockets");
+        return 1;
+    }
+
+    signal(SIGINT, parar);
+    signal(SIGTERM, parar);
+    inicio_s = agora();
+    printf("Coletor: telemetria UDP na porta %u, API em http://127.0.0.1:%u, intervalos de %u s\n",
+           porta_udp, porta_http, intervalo_s);
+
+    struct pollfd fds[2] = {
+        { .fd = udp, .events = POLLIN },
+        { .fd = http, .events = POLLIN },
+    };
+    while (executando) {
+        if (poll(fds, 2, 200) < 0 && errno != EINTR) break;
+        if (fds[0].revents & POLLIN) receber_telemetria(udp);
+        if (fds[1].revents & POLLIN) atender_consulta(http);
+        agregador_avancar(&agregador, agora());
+    }
+
+    printf("\nDatagramas: %llu | inválidos: %llu | dispositivos: %d\n",
+           (unsigned long long)agregador.datagramas, (unsigned long long)agregador.invalidos,
+           agregador.num_dispositivos);
+    close(udp);
+    close(http);
+    agregador_liberar(&agregador);
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * Descrição: Gravador do fluxo de amostras brutas do monitor (lib/fluxo_pcm.c) para calibração.
+ *            Abre a USB CDC, liga o fluxo, valida cada pacote pelo CRC, remonta a sequência pelo
+ *            índice das amostras, informa as lacunas (preenchidas com silêncio para manter a
+ *            base de tempo) e grava arquivos WAV PCM de 16 bits a 8 kHz.
+ *
+ * Uso: gravador_wav [-s dispositivo] [-o prefixo] [-d duracao_s] [-t segundos_por_arquivo]
+ */
+#define _DEFAULT_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fluxo_pcm.h"
+
+#define TAXA_HZ          8000
+#define OFFSET_ADC       2048
+#define LACUNA_MAX       TAXA_HZ   // Acima disso (1 s) a gravação recomeça em vez de preencher
+#define BUFFER_ENTRADA   8192
+
+typedef struct {
+    FILE *arquivo;
+    uint32_t amostras;
+    int numero;
+} wav_t;
+
+static volatile sig_atomic_t parar = 0;
+
+static void tratar_sinal(int sinal) {
+    (void)sinal;
+    parar = 1;
+}
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint16_t crc16(const uint8_t *dados, size_t n) {
+    uint16_t crc = FLUXO_PCM_CRC_INICIAL;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= (uint16_t)dados[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t ler_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ler_u32(const uint8_t *p) {
+    return ler_u16(p) | ((uint32_t)ler_u16(p + 2) << 16);
+}
+
+static void escrever_u16(FILE *f, uint16_t v) {
+    fputc(v & 0xFF, f);
+    fputc(v >> 8, f);
+}
+
+static void escrever_u32(FILE *f, uint32_t v) {
+    escrever_u16(f, v & 0xFFFF);
+    escrever_u16(f, v >> 16);
+}
+
+// Cabeçalho RIFF de PCM 16 bits mono; os tamanhos são corrigidos ao fechar
+static void escrever_cabecalho(FILE *f, uint32_t amostras) {
+    uint32_t bytes = amostras * 2;
+    fwrite("RIFF", 1, 4, f);
+    escrever_u32(f, 36 + bytes);
+    fwrite("WAVEfmt ", 1, 8, f);
+    escrever_u32(f, 16);
+    escrever_u16(f, 1);             // PCM
+    escrever_u16(f, 1);             // Mono
+    escrever_u32(f, TAXA_HZ);
+    escrever_u32(f, TAXA_HZ * 2);
+    escrever_u16(f, 2);
+    escrever_u16(f, 16);
+    fwrite("data", 1, 4, f);
+    escrever_u32(f, bytes);
+}
+
+static void wav_fechar(wav_t *w) {
+    if (!w->arquivo) return;
+    fseek(w->arquivo, 0, SEEK_SET);
+    escrever_cabecalho(w->arquivo, w->amostras);
+    fclose(w->arquivo);
+    w->arquivo = NULL;
+}
+
+static bool wav_abrir(wav_t *w, const char *prefixo) {
+    char nome[256];
+    snprintf(nome, sizeof(nome), "%s_%03d.wav", prefixo, w->numero++);
+    w->arquivo = fopen(nome, "wb");
+    if (!w->arquivo) {
+        fprintf(stderr, "Não foi possível criar %s: %s\n", nome, strerror(errno));
+        return false;
+    }
+    w->amostras = 0;
+    escrever_cabecalho(w->arquivo, 0);
+    printf("Gravando %s\n", nome);
+    return true;
+}
+
+// Amostra de 12 bits do ADC centrada em zero e escalada para 16 bits
+static void wav_amostra(wav_t *w, uint16_t adc) {
+    escrever_u16(w->arquivo, (uint16_t)(int16_t)(((int)adc - OFFSET_ADC) * 16));
+    w->amostras++;
+}
+
+static int abrir_serial(const char *dispositivo) {
+    int fd = open(dispositivo, O_RDWR | O_NOCTTY);
+    if (fd < 0) return -1;
+    struct termios t;
+    if (tcgetattr(fd, &t) == 0) {
+        cfmakeraw(&t);
+        t.c_cc[VMIN] = 0;
+        t.c_cc[VTIME] = 1;          // read() retorna após 100 ms sem dados
+        tcsetattr(fd, TCSANOW, &t);
+    }
+    tcflush(fd, TCIFLUSH);
+    return fd;
+}
+
+int main(int argc, char **argv) {
+    const char *dispositivo = "/dev/ttyACM0";
+    const char *prefixo = "gravacao";
+    double duracao = 0.0;
+    double por_arquivo = 0.0;
+
+    int opcao;
+    while ((opcao = getopt(argc, argv, "s:o:d:t:")) != -1) {
+        switch (opcao) {
+        case 's': dispositivo = optarg; break;
+        case 'o': prefixo = optarg; break;
+        case 'd': duracao = atof(optarg); break;
+        case 't': por_arquivo = atof(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s [-s dispositivo] [-o prefixo] [-d duracao_s] [-t segundos_por_arquivo]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    int fd = abrir_serial(dispositivo);
+    if (fd < 0) {
+        fprintf(stderr, "Não foi possível abrir %s: %s\n", dispositivo, strerror(errno));
+        return 1;
+    }
+    signal(SIGINT, tratar_sinal);
+    signal(SIGTERM, tratar_sinal);
+
+    const char iniciar = FLUXO_PCM_CMD_INICIAR;
+    if (write(fd, &iniciar, 1) != 1) {
+        fprintf(stderr, "Falha ao enviar o comando de início\n");
+        return 1;
+    }
+
+    wav_t wav = {0};
+    if (!wav_abrir(&wav, prefixo)) return 1;
+    uint32_t amostras_por_arquivo = (uint32_t)(por_arquivo * TAXA_HZ);
+
+    static uint8_t entrada[BUFFER_ENTRADA];
+    size_t ocupado = 0;
+    bool sincronizado = false;
+    uint32_t proximo_indice = 0, proxima_sequencia = 0;
+    unsigned long long pacotes = 0, erros_crc = 0, lacunas = 0, amostras_perdidas = 0, pacotes_perdidos = 0;
+    unsigned long long bytes_descartados = 0, amostras_recebidas = 0;
+    double inicio = agora();
+
+    while (!parar && (duracao <= 0.0 || agora() - inicio < duracao)) {
+        ssize_t n = read(fd, entrada + ocupado, sizeof(entrada) - ocupado);
+        if (n < 0 && errno != EINTR && errno != EAGAIN) {
+            fprintf(stderr, "Erro de leitura: %s\n", strerror(errno));
+            break;
+        }
+        if (n > 0) ocupado += (size_t)n;
+
+        size_t pos = 0;
+        while (ocupado - pos >= FLUXO_PCM_CABECALHO) {
+            const uint8_t *p = entrada + pos;
+            uint16_t quantidade = ler_u16(p + 12);
+            if (ler_u32(p) != FLUXO_PCM_MAGICO || quantidade > FLUXO_PCM_AMOSTRAS_MAX) {
+                pos++;              // Procura o próximo início de pacote
+                bytes_descartados++;
+                continue;
+            }
+            size_t tamanho = FLUXO_PCM_CABECALHO + 2 * quantidade + 2;
+            if (ocupado - pos < tamanho) break;
+            if (crc16(p, tamanho - 2) != ler_u16(p + tamanho - 2)) {
+                erros_crc++;
+                pos++;
+                bytes_descartados++;
+                continue;
+            }
+
+            uint32_t sequencia = ler_u32(p + 4);
+            uint32_t indice = ler_u32(p + 8);
+            if (sincronizado) {
+                if (sequencia != proxima_sequencia) pacotes_perdidos += (uint32_t)(sequencia - proxima_sequencia);
+                uint32_t faltando = indice - proximo_indice;
+                if (faltando > 0 && faltando <= LACUNA_MAX) {
+                    printf("[LACUNA] %lu amostras (%.1f ms) antes da amostra %lu, pacote %lu\n",
+                           (unsigned long)faltando, faltando * 1000.0 / TAXA_HZ, (unsigned long)indice,
+                           (unsigned long)sequencia);
+                    lacunas++;
+                    amostras_perdidas += faltando;
+                    for (uint32_t i = 0; i < faltando; i++) wav_amostra(&wav, OFFSET_ADC);
+                } else if (faltando != 0) {
+                    // Fluxo reiniciado ou lacuna longa demais: começa um arquivo novo
+                    printf("[LACUNA] Descontinuidade (amostra %lu, esperada %lu): novo arquivo\n",
+                           (unsigned long)indice, (unsigned long)proximo_indice);
+                    lacunas++;
+                    wav_fechar(&wav);
+                    if (!wav_abrir(&wav, prefixo)) return 1;
+                }
+            }
+            sincronizado = true;
+            proxima_sequencia = sequencia + 1;
+            proximo_indice = indice + quantidade;
+
+            for (uint16_t i = 0; i < quantidade; i++) {
+                wav_amostra(&wav, ler_u16(p + FLUXO_PCM_CABECALHO + 2 * i));
+            }
+            pacotes++;
+            amostras_recebidas += quantidade;
+            pos += tamanho;
+
+            if (amostras_por_arquivo && wav.amostras >= amostras_por_arquivo) {
+                wav_fechar(&wav);
+                if (!wav_abrir(&wav, prefixo)) return 1;
+            }
+        }
+        memmove(entrada, entrada + pos, ocupado - pos);
+        ocupado -= pos;
+    }
+
+    const char parar_fluxo = FLUXO_PCM_CMD_PARAR;
+    if (write(fd, &parar_fluxo, 1) != 1) fprintf(stderr, "Falha ao enviar o comando de parada\n");
+    close(fd);
+    wav_fechar(&wav);
+
+    double decorrido = agora() - inicio;
+    printf("Pacotes: %llu | pacotes perdidos: %llu | erros de CRC: %llu | bytes descartados: %llu\n",
+           pacotes, pacotes_perdidos, erros_crc, bytes_descartados);
+    printf("Lacunas: %llu (%llu amostras) | taxa recebida: %.0f amostras/s em %.1f s\n",
+           lacunas, amostras_perdidas, amostras_recebidas / decorrido, decorrido);
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef LWIPOPTS_UNIX_H
+#define LWIPOPTS_UNIX_H
+
+// Opções do lwIP para o servidor do host (port unix): as mesmas do firmware, para o TCP ter
+// os mesmos buffers, filas e limites de PCB, com os ajustes que o Linux exige
+#include "../../lib/lwipopts.h"
+
+#undef MEM_ALIGNMENT
+#define MEM_ALIGNMENT               8       // Ponteiros de 64 bits
+#undef LWIP_DHCP
+#define LWIP_DHCP                   0       // Endereço fixo na interface tap
+#undef SYS_LIGHTWEIGHT_PROT
+#define SYS_LIGHTWEIGHT_PROT        0       // NO_SYS em uma só thread
+
+#endif // LWIPOPTS_UNIX_H
@@ -0,0 +1,111 @@
+/*
+ * Descrição: Servidor HTTP do monitor (lib/servidor_http.c) no Linux, sobre o port unix do
+ *            lwIP e uma interface tap, para medir o pool de conexões com o carga_http sem a
+ *            placa. As rotas do firmware (lib/wifi_config.c) são substituídas por equivalentes
+ *            sem o SDK: / devolve uma página do tamanho do dashboard (enviada em partes),
+ *            /dados um JSON pequeno e /servidor as estatísticas do pool.
+ *
+ * Uso: PRECONFIGURED_TAPIF=tap0 servidor_unix [-a endereco] [-g gateway] [-p porta]
+ */
+#define _DEFAULT_SOURCE
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lwip/init.h"
+#include "lwip/netif.h"
+#include "lwip/timeouts.h"
+#include "lwip/ip4_addr.h"
+#include "netif/tapif.h"
+
+#include "servidor_http.h"
+
+#define TAMANHO_PAGINA 12000        // Da ordem do dashboard comprimido, maior que TCP_SND_BUF
+
+static uint8_t pagina[TAMANHO_PAGINA];
+static volatile sig_atomic_t parar = 0;
+
+static void tratar_sinal(int sinal) {
+    (void)sinal;
+    parar = 1;
+}
+
+static void responder_texto(servidor_http_conexao_t *conexao, const char *tipo, int tamanho) {
+    servidor_http_resposta_t r = {
+        .status = 200, .tipo = tipo,
+        .corpo = (const uint8_t *)servidor_http_corpo(conexao), .tamanho_corpo = (uint32_t)tamanho,
+    };
+    servidor_http_responder(conexao, &r);
+}
+
+static void rota(servidor_http_conexao_t *conexao, const char *requisicao) {
+    char *corpo = servidor_http_corpo(conexao);
+    if (strstr(requisicao, "GET /servidor")) {
+        responder_texto(conexao, "application/json", servidor_http_estatisticas_json(corpo, SERVIDOR_HTTP_CORPO_MAX));
+    } else if (strstr(requisicao, "GET /dados")) {
+        responder_texto(conexao, "application/json", snprintf(corpo, SERVIDOR_HTTP_CORPO_MAX,
+                        "{\"db\":%.1f,\"adc\":%d,\"amplitude\":%.1f}", 55.0, 2048, 12.5));
+    } else if (strncmp(requisicao, "GET / ", 6) == 0) {
+        servidor_http_resposta_t r = {
+            .status = 200, .tipo = "text/html; charset=utf-8", .corpo = pagina, .tamanho_corpo = TAMANHO_PAGINA,
+        };
+        servidor_http_responder(conexao, &r);
+    }
+    // Demais caminhos: o servidor responde 404
+}
+
+int main(int argc, char **argv) {
+    const char *endereco = "192.168.7.2";
+    const char *gateway = "192.168.7.1";
+    uint16_t porta = 80;
+
+    int opcao;
+    while ((opcao = getopt(argc, argv, "a:g:p:")) != -1) {
+        switch (opcao) {
+        case 'a': endereco = optarg; break;
+        case 'g': gateway = optarg; break;
+        case 'p': porta = (uint16_t)atoi(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s [-a endereco] [-g gateway] [-p porta]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ip4_addr_t ip, mascara, gw;
+    if (!ip4addr_aton(endereco, &ip) || !ip4addr_aton(gateway, &gw)) {
+        fprintf(stderr, "Endereço inválido\n");
+        return 1;
+    }
+    IP4_ADDR(&mascara, 255, 255, 255, 0);
+
+    for (int i = 0; i < TAMANHO_PAGINA; i++) pagina[i] = (uint8_t)('a' + i % 26);
+
+    lwip_init();
+    // Sem PRECONFIGURED_TAPIF o tapif cria o tap0 e o configura com o gateway (exige root)
+    static struct netif netif;
+    if (!netif_add(&netif, &ip, &mascara, &gw, NULL, tapif_init, netif_input)) {
+        fprintf(stderr, "Falha ao abrir a interface tap\n");
+        return 1;
+    }
+    netif_set_default(&netif);
+    netif_set_up(&netif);
+    netif_set_link_up(&netif);
+
+    if (!servidor_http_iniciar(porta, rota)) return 1;
+    printf("Servidor em http://%s:%u (Ctrl+C encerra)\n", endereco, porta);
+
+    signal(SIGINT, tratar_sinal);
+    signal(SIGTERM, tratar_sinal);
+    while (!parar) {
+        tapif_select(&netif);       // Espera um quadro ou o próximo timer do lwIP
+        sys_check_timeouts();
+    }
+
+    char json[256];
+    servidor_http_estatisticas_json(json, sizeof(json));
+    printf("%s\n", json);
+    return 0;
+}
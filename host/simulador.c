@@ -0,0 +1,116 @@
+/*
+ * Descrição: Simulador de frota para testar a ingestão do coletor.
+ *            Emula N monitores, cada um enviando o datagrama de telemetria de lib/telemetria.c
+ *            a uma taxa fixa, com níveis em passeio aleatório e zonas distribuídas entre eles.
+ *
+ * Uso: simulador [-n dispositivos] [-r envios_por_s_por_dispositivo] [-d duracao_s]
+ *                [-z zonas] [-h host] [-u porta_udp]
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetria.h"
+
+static double agora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    int num_dispositivos = 100;
+    double taxa = 1.0;
+    double duracao = 30.0;
+    int num_zonas = 4;
+    const char *host = "127.0.0.1";
+    uint16_t porta = TELEMETRIA_PORTA;
+
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:r:d:z:h:u:")) != -1) {
+        switch (opcao) {
+        case 'n': num_dispositivos = atoi(optarg); break;
+        case 'r': taxa = atof(optarg); break;
+        case 'd': duracao = atof(optarg); break;
+        case 'z': num_zonas = atoi(optarg); break;
+        case 'h': host = optarg; break;
+        case 'u': porta = (uint16_t)atoi(optarg); break;
+        default:
+            fprintf(stderr, "Uso: %s [-n dispositivos] [-r taxa] [-d duracao_s] [-z zonas] [-h host] [-u porta]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (num_dispositivos < 1 || taxa <= 0.0 || num_zonas < 1) {
+        fprintf(stderr, "Parâmetros inválidos\n");
+        return 1;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in destino = {0};
+    destino.sin_family = AF_INET;
+    destino.sin_port = htons(porta);
+    if (fd < 0 || inet_pton(AF_INET, host, &destino.sin_addr) != 1) {
+        fprintf(stderr, "Destino inválido: %s\n", host);
+        return 1;
+    }
+
+    float *niveis = malloc(num_dispositivos * sizeof(float));
+    unsigned long *sequencias = calloc(num_dispositivos, sizeof(unsigned long));
+    if (!niveis || !sequencias) return 1;
+    srand(1);
+    for (int i = 0; i < num_dispositivos; i++) niveis[i] = 45.0f + (rand() % 300) / 10.0f;
+
+    // Os envios são espalhados uniformemente dentro de cada período
+    double periodo_envio = 1.0 / (taxa * num_dispositivos);
+    double inicio = agora();
+    double proximo = inicio;
+    unsigned long long enviados = 0, falhas = 0;
+    int dispositivo = 0;
+
+    printf("Simulando %d dispositivos em %d zonas, %.1f envios/s cada (%.0f datagramas/s) para %s:%u\n",
+           num_dispositivos, num_zonas, taxa, taxa * num_dispositivos, host, porta);
+
+    while (agora() - inicio < duracao) {
+        double t = agora();
+        while (proximo <= t) {
+            float passo = ((rand() % 200) - 100) / 100.0f;
+            niveis[dispositivo] += passo;
+            if (niveis[dispositivo] < 30.0f) niveis[dispositivo] = 30.0f;
+            if (niveis[dispositivo] > 110.0f) niveis[dispositivo] = 110.0f;
+
+            char id[TELEMETRIA_TAMANHO_ID];
+            char zona[TELEMETRIA_TAMANHO_ID];
+            char mensagem[TELEMETRIA_TAMANHO_MAX];
+            snprintf(id, sizeof(id), "SIM%05d", dispositivo);
+            snprintf(zona, sizeof(zona), "zona%d", dispositivo % num_zonas + 1);
+            int n = snprintf(mensagem, sizeof(mensagem), TELEMETRIA_FORMATO, id, zona,
+                             ++sequencias[dispositivo], niveis[dispositivo], niveis[dispositivo] + 3.0f);
+
+            if (sendto(fd, mensagem, n, 0, (struct sockaddr *)&destino, sizeof(destino)) == n) enviados++;
+            else falhas++;
+
+            dispositivo = (dispositivo + 1) % num_dispositivos;
+            proximo += periodo_envio;
+        }
+        double espera = proximo - agora();
+        if (espera > 0.0005) {
+            struct timespec ts = { 0, (long)(espera * 1e9) };
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    double decorrido = agora() - inicio;
+    printf("Enviados: %llu (%.0f/s) | falhas de envio: %llu\n", enviados, enviados / decorrido, falhas);
+    printf("Compare com \"datagramas\" em GET /estatisticas do coletor para medir perdas.\n");
+    free(niveis);
+    free(sequencias);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,100 @@
+#ifndef LWIP_FALSO_TCP_H
+#define LWIP_FALSO_TCP_H
+
+#include <stdint.h>
+#include "lwipopts.h"
+
+// Substituto mínimo da API raw de TCP do lwIP para testar lib/servidor_http.c no host sem
+// rede: as escritas ficam registradas e as confirmações são dadas pelo teste (lwip_falso.c).
+// Tipos, constantes e assinaturas seguem o lwIP 2.1 com as opções de lib/lwipopts.h. Como no
+// lwIP, tcp_new() falha quando já há MEMP_NUM_TCP_PCB conexões (o PCB de escuta não conta).
+typedef uint8_t u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef int8_t err_t;
+
+#define ERR_OK    0
+#define ERR_MEM  -1
+#define ERR_VAL  -6
+#define ERR_ABRT -13
+#define ERR_RST  -14
+
+#define TCP_WRITE_FLAG_COPY   0x01
+#define TCP_WRITE_FLAG_MORE   0x02
+
+typedef struct { u32_t addr; } ip_addr_t;
+extern const ip_addr_t ip_addr_any;
+#define IP_ADDR_ANY (&ip_addr_any)
+
+struct pbuf {
+    struct pbuf *next;
+    void *payload;
+    u16_t tot_len;
+    u16_t len;
+};
+
+struct tcp_pcb;
+typedef err_t (*tcp_accept_fn)(void *arg, struct tcp_pcb *newpcb, err_t err);
+typedef err_t (*tcp_recv_fn)(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
+typedef err_t (*tcp_sent_fn)(void *arg, struct tcp_pcb *tpcb, u16_t len);
+typedef err_t (*tcp_poll_fn)(void *arg, struct tcp_pcb *tpcb);
+typedef void (*tcp_err_fn)(void *arg, err_t err);
+
+struct tcp_pcb {
+    void *callback_arg;
+    tcp_accept_fn accept;
+    tcp_recv_fn recv;
+    tcp_sent_fn sent;
+    tcp_poll_fn poll;
+    tcp_err_fn errf;
+    u8_t pollinterval;
+    u16_t snd_buf;
+
+    // Estado observado pelos testes
+    int escuta;
+    int fechado;
+    int abortado;
+    u32_t recebidos_confirmados;    // Soma de tcp_recved()
+    u32_t escritas;
+    u32_t maior_escrita;
+    u32_t em_voo;                   // Escrito e ainda não confirmado
+    u32_t saidas;                   // Chamadas de tcp_output()
+};
+
+#define tcp_sndbuf(pcb) ((pcb)->snd_buf)
+#define tcp_listen(pcb) tcp_listen_with_backlog(pcb, 0xff)
+
+struct tcp_pcb *tcp_new(void);
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port);
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog);
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept);
+void tcp_arg(struct tcp_pcb *pcb, void *arg);
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv);
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent);
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval);
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err);
+void tcp_recved(struct tcp_pcb *pcb, u16_t len);
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags);
+err_t tcp_output(struct tcp_pcb *pcb);
+err_t tcp_close(struct tcp_pcb *pcb);
+void tcp_abort(struct tcp_pcb *pcb);
+
+u8_t pbuf_free(struct pbuf *p);
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset);
+
+// --- Controle do teste (lwip_falso.c) ---
+
+// Conexão nova entregue ao callback de accept do PCB em escuta; retorna o PCB ou NULL se recusada
+struct tcp_pcb *falso_conectar(void);
+// Cliente envia texto (NULL = FIN); retorna o err_t do callback de recepção
+err_t falso_enviar(struct tcp_pcb *pcb, const char *texto);
+// Cliente confirma até "bytes" do que está em voo; retorna o err_t do callback de envio
+err_t falso_confirmar(struct tcp_pcb *pcb, u32_t bytes);
+err_t falso_poll(struct tcp_pcb *pcb);
+// Bytes já escritos na conexão (resposta montada na ordem das escritas)
+const char *falso_saida(struct tcp_pcb *pcb, u32_t *tamanho);
+// As próximas "n" chamadas de tcp_write() falham com ERR_MEM
+void falso_falhar_escritas(int n);
+int falso_pcbs_ativos(void);
+
+#endif // LWIP_FALSO_TCP_H
@@ -0,0 +1,169 @@
+#include "lwip/tcp.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PCBS_MAX   (MEMP_NUM_TCP_PCB + 1)   // Conexões e o PCB de escuta
+#define SAIDA_MAX  65536
+
+const ip_addr_t ip_addr_any = { 0 };
+
+static struct tcp_pcb pcbs[PCBS_MAX];
+static int em_uso[PCBS_MAX];
+static char saidas[PCBS_MAX][SAIDA_MAX];
+static u32_t tamanhos_saida[PCBS_MAX];
+static struct tcp_pcb *escuta = NULL;
+static int escritas_falhando = 0;
+
+static int indice(const struct tcp_pcb *pcb) {
+    return (int)(pcb - pcbs);
+}
+
+static void liberar(struct tcp_pcb *pcb) {
+    em_uso[indice(pcb)] = 0;
+}
+
+struct tcp_pcb *tcp_new(void) {
+    if (falso_pcbs_ativos() >= MEMP_NUM_TCP_PCB) return NULL;
+
+    for (int i = 0; i < PCBS_MAX; i++) {
+        if (!em_uso[i]) {
+            memset(&pcbs[i], 0, sizeof(pcbs[i]));
+            em_uso[i] = 1;
+            tamanhos_saida[i] = 0;
+            pcbs[i].snd_buf = TCP_SND_BUF;
+            return &pcbs[i];
+        }
+    }
+    return NULL;
+}
+
+err_t tcp_bind(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port) {
+    (void)pcb; (void)ipaddr; (void)port;
+    return ERR_OK;
+}
+
+struct tcp_pcb *tcp_listen_with_backlog(struct tcp_pcb *pcb, u8_t backlog) {
+    (void)backlog;
+    pcb->escuta = 1;
+    escuta = pcb;
+    return pcb;
+}
+
+void tcp_accept(struct tcp_pcb *pcb, tcp_accept_fn accept) { pcb->accept = accept; }
+void tcp_arg(struct tcp_pcb *pcb, void *arg) { pcb->callback_arg = arg; }
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv) { pcb->recv = recv; }
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent) { pcb->sent = sent; }
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err) { pcb->errf = err; }
+
+void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval) {
+    pcb->poll = poll;
+    pcb->pollinterval = interval;
+}
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len) {
+    pcb->recebidos_confirmados += len;
+}
+
+// Como no lwIP: sem espaço no buffer de envio a escrita falha com ERR_MEM
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags) {
+    (void)apiflags;
+    if (escritas_falhando > 0) {
+        escritas_falhando--;
+        return ERR_MEM;
+    }
+    if (len > pcb->snd_buf) return ERR_MEM;
+
+    int i = indice(pcb);
+    if (tamanhos_saida[i] + len <= SAIDA_MAX) {
+        memcpy(saidas[i] + tamanhos_saida[i], dataptr, len);
+        tamanhos_saida[i] += len;
+    }
+    pcb->snd_buf -= len;
+    pcb->em_voo += len;
+    pcb->escritas++;
+    if (len > pcb->maior_escrita) pcb->maior_escrita = len;
+    return ERR_OK;
+}
+
+err_t tcp_output(struct tcp_pcb *pcb) {
+    pcb->saidas++;
+    return ERR_OK;
+}
+
+// O fechamento ordenado sempre tem memória aqui; o PCB deixa de chamar os callbacks
+err_t tcp_close(struct tcp_pcb *pcb) {
+    pcb->fechado = 1;
+    liberar(pcb);
+    return ERR_OK;
+}
+
+// Como no lwIP, o callback de erro ainda registrado é chamado com ERR_ABRT
+void tcp_abort(struct tcp_pcb *pcb) {
+    pcb->abortado = 1;
+    liberar(pcb);
+    if (pcb->errf) pcb->errf(pcb->callback_arg, ERR_ABRT);
+}
+
+u8_t pbuf_free(struct pbuf *p) {
+    free(p);
+    return 1;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *p, void *dataptr, u16_t len, u16_t offset) {
+    if (offset >= p->tot_len) return 0;
+    if (len > p->tot_len - offset) len = p->tot_len - offset;
+    memcpy(dataptr, (const char *)p->payload + offset, len);
+    return len;
+}
+
+struct tcp_pcb *falso_conectar(void) {
+    struct tcp_pcb *pcb = tcp_new();
+    if (!pcb || !escuta || !escuta->accept) return NULL;
+    if (escuta->accept(escuta->callback_arg, pcb, ERR_OK) != ERR_OK) return NULL;
+    return pcb;
+}
+
+err_t falso_enviar(struct tcp_pcb *pcb, const char *texto) {
+    if (!em_uso[indice(pcb)] || !pcb->recv) return ERR_VAL;
+    if (!texto) return pcb->recv(pcb->callback_arg, pcb, NULL, ERR_OK);
+
+    size_t n = strlen(texto);
+    struct pbuf *p = malloc(sizeof(struct pbuf) + n);
+    p->next = NULL;
+    p->payload = p + 1;
+    p->tot_len = p->len = (u16_t)n;
+    memcpy(p->payload, texto, n);
+    return pcb->recv(pcb->callback_arg, pcb, p, ERR_OK);
+}
+
+err_t falso_confirmar(struct tcp_pcb *pcb, u32_t bytes) {
+    if (!em_uso[indice(pcb)]) return ERR_VAL;
+    if (bytes > pcb->em_voo) bytes = pcb->em_voo;
+    pcb->em_voo -= bytes;
+    pcb->snd_buf += bytes;
+    if (!pcb->sent || bytes == 0) return ERR_OK;
+    return pcb->sent(pcb->callback_arg, pcb, (u16_t)bytes);
+}
+
+err_t falso_poll(struct tcp_pcb *pcb) {
+    if (!em_uso[indice(pcb)] || !pcb->poll) return ERR_VAL;
+    return pcb->poll(pcb->callback_arg, pcb);
+}
+
+const char *falso_saida(struct tcp_pcb *pcb, u32_t *tamanho) {
+    *tamanho = tamanhos_saida[indice(pcb)];
+    return saidas[indice(pcb)];
+}
+
+void falso_falhar_escritas(int n) {
+    escritas_falhando = n;
+}
+
+// PCBs de conexão ainda abertos (o de escuta não conta)
+int falso_pcbs_ativos(void) {
+    int n = 0;
+    for (int i = 0; i < PCBS_MAX; i++) {
+        if (em_uso[i] && !pcbs[i].escuta) n++;
+    }
+    return n;
+}
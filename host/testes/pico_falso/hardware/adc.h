@@ -0,0 +1,22 @@
+#ifndef PICO_FALSO_ADC_H
+#define PICO_FALSO_ADC_H
+
+#include "pico/stdlib.h"
+
+void adc_select_input(uint input);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_fifo_drain(void);
+bool adc_fifo_is_empty(void);
+uint16_t adc_fifo_get(void);
+void adc_irq_set_enabled(bool enabled);
+void adc_run(bool run);
+
+// --- Controle do teste (pico_falso.c) ---
+
+// Coloca as amostras no FIFO de 4 em 4 (o limiar de captura_iniciar) e chama a interrupção
+// a cada grupo, se o ADC estiver rodando com a interrupção habilitada; senão são descartadas.
+// O relógio avança 125 us por amostra (8 kHz).
+void falso_adc_amostras(const uint16_t *amostras, int n);
+
+#endif // PICO_FALSO_ADC_H
@@ -0,0 +1,13 @@
+#ifndef PICO_FALSO_IRQ_H
+#define PICO_FALSO_IRQ_H
+
+#include "pico/stdlib.h"
+
+typedef void (*irq_handler_t)(void);
+
+#define ADC_IRQ_FIFO 22
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+
+#endif // PICO_FALSO_IRQ_H
@@ -0,0 +1,11 @@
+#ifndef PICO_FALSO_SYNC_H
+#define PICO_FALSO_SYNC_H
+
+#include <stdint.h>
+
+// No host a interrupção falsa só roda dentro de falso_adc_amostras(), nunca no meio do código
+// testado: desabilitar interrupções não precisa fazer nada
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+
+#endif // PICO_FALSO_SYNC_H
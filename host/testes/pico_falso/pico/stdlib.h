@@ -0,0 +1,20 @@
+#ifndef PICO_FALSO_STDLIB_H
+#define PICO_FALSO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Substituto mínimo do SDK do Pico para testar lib/captura_audio.c no host: o relógio é
+// avançado pelo teste e as amostras do ADC são entregues pela interrupção falsa
+// (pico_falso.c). Tipos e assinaturas seguem o SDK 1.5.
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time(void);
+uint32_t to_ms_since_boot(absolute_time_t t);
+
+// --- Controle do teste (pico_falso.c) ---
+
+void falso_avancar_us(uint64_t us);
+
+#endif // PICO_FALSO_STDLIB_H
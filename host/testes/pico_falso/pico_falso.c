@@ -0,0 +1,80 @@
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/irq.h"
+#include <stddef.h>
+
+#define FIFO_LIMIAR 4   // Mesmo limiar de captura_iniciar()
+
+static uint64_t agora_us = 0;
+static irq_handler_t tratador_adc = NULL;
+static bool irq_adc = false;
+static bool irq_fifo = false;
+static bool rodando = false;
+
+static uint16_t fifo[FIFO_LIMIAR];
+static int fifo_leitura = 0;
+static int fifo_escrita = 0;
+
+absolute_time_t get_absolute_time(void) {
+    return agora_us;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+void falso_avancar_us(uint64_t us) {
+    agora_us += us;
+}
+
+void adc_select_input(uint input) {
+    (void)input;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)en; (void)dreq_en; (void)dreq_thresh; (void)err_in_fifo; (void)byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    (void)clkdiv;
+}
+
+void adc_fifo_drain(void) {
+    fifo_leitura = fifo_escrita = 0;
+}
+
+bool adc_fifo_is_empty(void) {
+    return fifo_leitura == fifo_escrita;
+}
+
+uint16_t adc_fifo_get(void) {
+    return fifo_leitura < fifo_escrita ? fifo[fifo_leitura++] : 0;
+}
+
+void adc_irq_set_enabled(bool enabled) {
+    irq_adc = enabled;
+}
+
+void adc_run(bool run) {
+    rodando = run;
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    if (num == ADC_IRQ_FIFO) tratador_adc = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num == ADC_IRQ_FIFO) irq_fifo = enabled;
+}
+
+void falso_adc_amostras(const uint16_t *amostras, int n) {
+    for (int i = 0; i < n; i++) {
+        agora_us += 125;
+        if (!rodando) continue;
+        fifo[fifo_escrita++] = amostras[i];
+        if (fifo_escrita == FIFO_LIMIAR) {
+            if (tratador_adc && irq_adc && irq_fifo) tratador_adc();
+            adc_fifo_drain();
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef TESTE_H
+#define TESTE_H
+
+#include <math.h>
+#include <stdio.h>
+
+// Verificações mínimas dos testes do host: cada falha é impressa com arquivo e linha,
+// e o teste termina com TESTE_RESULTADO() (código de saída diferente de zero se algo falhou)
+static int teste_falhas = 0;
+
+#define VERIFICAR(condicao) do { \
+    if (!(condicao)) { \
+        printf("FALHOU %s:%d: %s\n", __FILE__, __LINE__, #condicao); \
+        teste_falhas++; \
+    } \
+} while (0)
+
+#define VERIFICAR_PROXIMO(obtido, esperado, tolerancia) do { \
+    double obtido_ = (obtido), esperado_ = (esperado); \
+    if (!(fabs(obtido_ - esperado_) <= (tolerancia))) { \
+        printf("FALHOU %s:%d: %s = %.4f, esperado %.4f (tolerância %.4f)\n", \
+               __FILE__, __LINE__, #obtido, obtido_, esperado_, (double)(tolerancia)); \
+        teste_falhas++; \
+    } \
+} while (0)
+
+#define TESTE_RESULTADO() (printf("%s: %s\n", __FILE__, teste_falhas ? "FALHOU" : "OK"), teste_falhas != 0)
+
+#endif // TESTE_H
@@ -0,0 +1,109 @@
+/*
+ * Descrição: Testes de lib/adpcm.c no host. Codifica e decodifica um trecho do tamanho de um
+ *            clip (lib/captura_audio.h) e verifica a relação sinal-ruído, a primeira amostra sem
+ *            compressão de cada bloco, o índice do passo levado de um bloco ao seguinte e que o
+ *            decodificador reconstrói exatamente o preditor do codificador. As amostras do ADC
+ *            passam pela mesma conversão do firmware (captura_converter_amostra()).
+ */
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <string.h>
+
+#include "adpcm.h"
+#include "captura_audio.h"
+#include "teste.h"
+
+#define BLOCOS       CAPTURA_BLOCOS_POR_CLIP
+#define AMOSTRAS     (BLOCOS * ADPCM_AMOSTRAS_POR_BLOCO)
+#define TAXA_HZ      8000.0
+
+static int16_t original[AMOSTRAS];
+static int16_t decodificado[AMOSTRAS];
+static uint8_t dados[BLOCOS * ADPCM_BYTES_POR_BLOCO];
+
+static uint32_t semente = 777;
+static double aleatorio(void) {
+    semente = semente * 1664525u + 1013904223u;
+    return (semente >> 8) / 16777216.0 - 0.5;
+}
+
+// Leitura de 12 bits do ADC: o sinal analógico satura em 0 e 4095
+static uint16_t adc(double v) {
+    return (uint16_t)(v < 0.0 ? 0.0 : (v > 4095.0 ? 4095.0 : v));
+}
+
+// Codifica o trecho inteiro como um clip, conferindo o cabeçalho de cada bloco
+static void ida_e_volta(void) {
+    adpcm_estado_t codificador;
+    adpcm_iniciar(&codificador);
+    for (int b = 0; b < BLOCOS; b++) {
+        int32_t indice_antes = codificador.indice;
+        uint8_t *bloco = &dados[b * ADPCM_BYTES_POR_BLOCO];
+        adpcm_codificar_bloco(&codificador, &original[b * ADPCM_AMOSTRAS_POR_BLOCO], bloco);
+        VERIFICAR(bloco[2] == indice_antes);
+        VERIFICAR(bloco[3] == 0);
+
+        int16_t *saida = &decodificado[b * ADPCM_AMOSTRAS_POR_BLOCO];
+        adpcm_decodificar_bloco(bloco, saida);
+        VERIFICAR(saida[0] == original[b * ADPCM_AMOSTRAS_POR_BLOCO]);
+        VERIFICAR(saida[ADPCM_AMOSTRAS_POR_BLOCO - 1] == codificador.preditor);
+    }
+}
+
+static double snr_db(void) {
+    double sinal = 0.0, erro = 0.0;
+    for (int i = 0; i < AMOSTRAS; i++) {
+        double e = (double)decodificado[i] - original[i];
+        sinal += (double)original[i] * original[i];
+        erro += e * e;
+    }
+    return 10.0 * log10(sinal / (erro > 0.0 ? erro : 1e-9));
+}
+
+// Tom de 440 Hz com ruído, nível típico de um disparo
+static void testar_tom(void) {
+    for (int i = 0; i < AMOSTRAS; i++) {
+        double v = 2048.0 + 900.0 * sin(2.0 * M_PI * 440.0 * i / TAXA_HZ) + 40.0 * aleatorio();
+        original[i] = captura_converter_amostra(adc(v), 2048);
+    }
+    ida_e_volta();
+    double snr = snr_db();
+    printf("Tom de 440 Hz: SNR %.1f dB\n", snr);
+    VERIFICAR(snr > 25.0);
+}
+
+// Microfone saturado com offset calibrado abaixo de 2048 (o caso que provocava a volta do int16)
+static void testar_saturado(void) {
+    for (int i = 0; i < AMOSTRAS; i++) {
+        double v = 2040.0 + 3000.0 * sin(2.0 * M_PI * 200.0 * i / TAXA_HZ);
+        original[i] = captura_converter_amostra(adc(v), 2040);
+    }
+    VERIFICAR(captura_converter_amostra(4095, 2040) == INT16_MAX);
+    VERIFICAR(captura_converter_amostra(0, 2040) == -2040 * 16);
+    VERIFICAR(captura_converter_amostra(0, 2100) == INT16_MIN);
+    VERIFICAR(original[ADPCM_AMOSTRAS_POR_BLOCO / 4] > 0);     // Pico positivo limitado, não negativo
+    ida_e_volta();
+    double snr = snr_db();
+    printf("Saturado: SNR %.1f dB\n", snr);
+    VERIFICAR(snr > 20.0);
+}
+
+// Silêncio decodifica como silêncio
+static void testar_silencio(void) {
+    memset(original, 0, sizeof(original));
+    ida_e_volta();
+    int maximo = 0;
+    for (int i = 0; i < AMOSTRAS; i++) {
+        int v = decodificado[i] < 0 ? -decodificado[i] : decodificado[i];
+        if (v > maximo) maximo = v;
+    }
+    VERIFICAR(maximo <= 8);
+}
+
+int main(void) {
+    testar_tom();
+    testar_saturado();
+    testar_silencio();
+    return TESTE_RESULTADO();
+}
@@ -0,0 +1,137 @@
+/*
+ * Descrição: Testes de lib/agendador.c no host com um relógio simulado. As tarefas avançam o
+ *            relógio para simular a própria duração; o teste verifica a ordem por prazo mais
+ *            cedo, as liberações puladas contadas em estouros, o jitter e o próximo prazo retornado.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "agendador.h"
+#include "teste.h"
+
+static uint64_t relogio = 0;
+static uint64_t relogio_simulado(void) {
+    return relogio;
+}
+
+// Cada tarefa anota a ordem de execução e ocupa "duracao_us" do relógio simulado
+typedef struct {
+    char nome;
+    uint64_t duracao_us;
+} tarefa_teste_t;
+
+static char ordem[32];
+static int num_ordem = 0;
+
+static void executar(void *contexto) {
+    tarefa_teste_t *t = contexto;
+    if (num_ordem < (int)sizeof(ordem) - 1) ordem[num_ordem++] = t->nome;
+    ordem[num_ordem] = '\0';
+    relogio += t->duracao_us;
+}
+
+static void limpar_ordem(void) {
+    num_ordem = 0;
+    ordem[0] = '\0';
+}
+
+// Vencidas ao mesmo tempo rodam na ordem de prazo, não na de cadastro
+static void testar_ordem_e_jitter(void) {
+    static agendador_t ag;
+    tarefa_teste_t a = {'A', 0}, b = {'B', 0}, c = {'C', 0};
+    relogio = 0;
+    agendador_iniciar(&ag, relogio_simulado);
+    VERIFICAR(agendador_executar(&ag) == UINT64_MAX);
+    VERIFICAR(agendador_adicionar(&ag, "a", executar, &a, 30) == 0);
+    VERIFICAR(agendador_adicionar(&ag, "b", executar, &b, 10) == 1);
+    VERIFICAR(agendador_adicionar(&ag, "c", executar, &c, 20) == 2);
+
+    // Primeira liberação é imediata; empate fica na ordem de cadastro
+    limpar_ordem();
+    VERIFICAR(agendador_executar(&ag) == 10);
+    VERIFICAR(strcmp(ordem, "ABC") == 0);
+
+    // Acordando em 35: prazos B=10, C=20, A=30 vencidos
+    relogio = 35;
+    limpar_ordem();
+    uint64_t proximo = agendador_executar(&ag);
+    VERIFICAR(strcmp(ordem, "BCA") == 0);
+    VERIFICAR(ag.tarefas[1].jitter_max_us == 25);
+    VERIFICAR(ag.tarefas[2].jitter_max_us == 15);
+    VERIFICAR(ag.tarefas[0].jitter_max_us == 5);
+    VERIFICAR(ag.tarefas[0].jitter_soma_us == 5);
+
+    // B perdeu as liberações de 20 e 30 e volta à grade em 40; C e A não perderam nenhuma
+    VERIFICAR(ag.tarefas[1].estouros == 2);
+    VERIFICAR(ag.tarefas[1].proximo_us == 40);
+    VERIFICAR(ag.tarefas[2].estouros == 0);
+    VERIFICAR(ag.tarefas[2].proximo_us == 40);
+    VERIFICAR(ag.tarefas[0].estouros == 0);
+    VERIFICAR(ag.tarefas[0].proximo_us == 60);
+    VERIFICAR(proximo == 40);
+
+    // Antes do prazo nada roda e o mesmo prazo é retornado
+    relogio = 39;
+    limpar_ordem();
+    VERIFICAR(agendador_executar(&ag) == 40);
+    VERIFICAR(num_ordem == 0);
+
+    agendador_zerar_estatisticas(&ag);
+    VERIFICAR(ag.tarefas[1].estouros == 0);
+    VERIFICAR(ag.tarefas[1].execucoes == 0);
+    VERIFICAR(ag.tarefas[1].jitter_max_us == 0);
+    VERIFICAR(ag.tarefas[1].proximo_us == 40);
+}
+
+// Uma execução mais longa que o período pula as liberações que passaram durante ela
+static void testar_execucao_longa(void) {
+    static agendador_t ag;
+    tarefa_teste_t lenta = {'L', 25}, rapida = {'R', 1};
+    relogio = 1000;
+    agendador_iniciar(&ag, relogio_simulado);
+    agendador_adicionar(&ag, "lenta", executar, &lenta, 10);
+    agendador_adicionar(&ag, "rapida", executar, &rapida, 100);
+
+    limpar_ordem();
+    uint64_t proximo = agendador_executar(&ag);
+    // L termina em 1025 (pula 1010 e 1020, volta em 1030); R começa atrasada 25 us
+    VERIFICAR(strcmp(ordem, "LR") == 0);
+    VERIFICAR(ag.tarefas[0].estouros == 2);
+    VERIFICAR(ag.tarefas[0].duracao_max_us == 25);
+    VERIFICAR(ag.tarefas[0].proximo_us == 1030);
+    VERIFICAR(ag.tarefas[1].jitter_max_us == 25);
+    VERIFICAR(ag.tarefas[1].proximo_us == 1100);
+    VERIFICAR(proximo == 1030);
+
+    // Exatamente no prazo: sem jitter; terminar em 1055 pula 1040 e 1050
+    relogio = 1030;
+    limpar_ordem();
+    VERIFICAR(agendador_executar(&ag) == 1060);
+    VERIFICAR(strcmp(ordem, "L") == 0);
+    VERIFICAR(ag.tarefas[0].jitter_max_us == 0);
+    VERIFICAR(ag.tarefas[0].estouros == 4);
+    VERIFICAR(ag.tarefas[0].execucoes == 2);
+}
+
+static void nada(void *contexto) {
+    (void)contexto;
+}
+
+static void testar_limites(void) {
+    static agendador_t ag;
+    relogio = 0;
+    agendador_iniciar(&ag, relogio_simulado);
+    VERIFICAR(agendador_adicionar(&ag, "zero", nada, NULL, 0) == -1);
+    for (int i = 0; i < AGENDADOR_MAX_TAREFAS; i++) {
+        VERIFICAR(agendador_adicionar(&ag, "t", nada, NULL, 100 + i) == i);
+    }
+    VERIFICAR(agendador_adicionar(&ag, "extra", nada, NULL, 100) == -1);
+    VERIFICAR(agendador_executar(&ag) == 100);
+}
+
+int main(void) {
+    testar_ordem_e_jitter();
+    testar_execucao_longa();
+    testar_limites();
+    return TESTE_RESULTADO();
+}
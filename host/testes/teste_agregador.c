@@ -0,0 +1,213 @@
+/*
+ * Descrição: Testes de host/agregador.c. Datagramas de telemetria com instantes escolhidos pelo
+ *            teste verificam o alinhamento das leituras aos intervalos do relógio do coletor, a
+ *            saída dos intervalos antigos do anel (e o descarte do histórico depois de uma lacuna
+ *            maior que a janela), as leituras em lote colocadas no intervalo em que foram medidas,
+ *            a agregação por zona e os níveis perto do fundo de escala do medidor.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "agregador.h"
+#include "telemetria.h"
+#include "teste.h"
+
+static agregador_t ag;
+
+static bool enviar(const char *id, const char *zona, unsigned long sequencia, float leq, float maximo,
+                   unsigned long idade_s, double agora_s) {
+    char mensagem[TELEMETRIA_TAMANHO_MAX + 1];
+    int n = idade_s ? snprintf(mensagem, sizeof(mensagem), TELEMETRIA_FORMATO_LOTE, id, zona, sequencia, leq, maximo, idade_s)
+                    : snprintf(mensagem, sizeof(mensagem), TELEMETRIA_FORMATO, id, zona, sequencia, leq, maximo);
+    return agregador_ingerir(&ag, mensagem, (size_t)n, agora_s);
+}
+
+static agreg_resumo_t resumo_de(const char *id) {
+    agreg_resumo_t r;
+    int i = agregador_buscar(&ag, id);
+    VERIFICAR(i >= 0);
+    memset(&r, 0, sizeof(r));
+    if (i >= 0) agregador_resumo_dispositivo(&ag, i, &r);
+    return r;
+}
+
+static double db(double energia) {
+    return 10.0 * log10(energia);
+}
+
+static double energia(double nivel) {
+    return pow(10.0, nivel / 10.0);
+}
+
+// Leituras de 100 s a 109,9 s caem no mesmo intervalo de 10 s; a de 110 s abre o seguinte.
+// Só intervalos fechados entram no resumo.
+static void testar_alinhamento(void) {
+    VERIFICAR(agregador_iniciar(&ag, 10));
+    VERIFICAR(enviar("a", "z", 1, 60.0f, 65.0f, 0, 100.0));
+    VERIFICAR(enviar("a", "z", 2, 70.0f, 75.0f, 0, 105.0));
+    VERIFICAR(enviar("a", "z", 3, 60.0f, 62.0f, 0, 109.9));
+    VERIFICAR(resumo_de("a").intervalos == 0);
+
+    VERIFICAR(enviar("a", "z", 4, 80.0f, 85.0f, 0, 110.0));
+    agreg_resumo_t r = resumo_de("a");
+    VERIFICAR(r.intervalos == 1);
+    VERIFICAR_PROXIMO(r.leq, db((2.0 * energia(60.0) + energia(70.0)) / 3.0), 0.01);
+    VERIFICAR(r.maximo == 75.0f);
+
+    agregador_avancar(&ag, 119.9);
+    VERIFICAR(resumo_de("a").intervalos == 1);
+    agregador_avancar(&ag, 120.0);
+    r = resumo_de("a");
+    VERIFICAR(r.intervalos == 2);
+    VERIFICAR_PROXIMO(r.leq, db(((2.0 * energia(60.0) + energia(70.0)) / 3.0 + energia(80.0)) / 2.0), 0.01);
+    VERIFICAR(r.maximo == 85.0f);
+
+    // Intervalos sem leituras não contam na média
+    agregador_avancar(&ag, 200.0);
+    VERIFICAR(resumo_de("a").intervalos == 2);
+
+    // Mensagem fora do protocolo
+    VERIFICAR(!agregador_ingerir(&ag, "MR2 x", 5, 200.0));
+    VERIFICAR(ag.invalidos == 1);
+    agregador_liberar(&ag);
+}
+
+// Uma leitura por intervalo de 1 s: depois de AGREG_HISTORICO intervalos a 50 dB, os
+// intervalos a 90 dB vão substituindo os mais antigos no anel
+static void testar_anel(void) {
+    VERIFICAR(agregador_iniciar(&ag, 1));
+    double t = 0.0;
+    unsigned long sequencia = 1;
+    for (int i = 0; i < AGREG_HISTORICO; i++, t += 1.0) enviar("b", "z", sequencia++, 50.0f, 55.0f, 0, t);
+    for (int i = 0; i < AGREG_HISTORICO / 2; i++, t += 1.0) enviar("b", "z", sequencia++, 90.0f, 95.0f, 0, t);
+    agregador_avancar(&ag, t);
+
+    agreg_resumo_t r = resumo_de("b");
+    VERIFICAR(r.intervalos == AGREG_HISTORICO);
+    VERIFICAR_PROXIMO(r.leq, db((energia(50.0) + energia(90.0)) / 2.0), 0.01);
+    VERIFICAR(r.maximo == 95.0f);
+    VERIFICAR(r.l10 == 90.5f);
+    VERIFICAR(r.l50 == 50.5f);
+    VERIFICAR(r.l90 == 50.5f);
+
+    // A outra metade: nada de 50 dB sobra na janela
+    for (int i = 0; i < AGREG_HISTORICO / 2; i++, t += 1.0) enviar("b", "z", sequencia++, 90.0f, 95.0f, 0, t);
+    agregador_avancar(&ag, t);
+    r = resumo_de("b");
+    VERIFICAR(r.intervalos == AGREG_HISTORICO);
+    VERIFICAR_PROXIMO(r.leq, 90.0, 0.01);
+    VERIFICAR(r.l90 == 90.5f);
+
+    // Parte da janela vazia: os intervalos sem dados saem sem deixar contas negativas
+    agregador_avancar(&ag, t + AGREG_HISTORICO - 10);
+    r = resumo_de("b");
+    VERIFICAR(r.intervalos == 10);
+    VERIFICAR_PROXIMO(r.leq, 90.0, 0.01);
+
+    // Lacuna maior que a janela: o histórico inteiro é descartado
+    t += 2.0 * AGREG_HISTORICO;
+    enviar("b", "z", sequencia++, 70.0f, 71.0f, 0, t);
+    agregador_avancar(&ag, t + 1.0);
+    r = resumo_de("b");
+    VERIFICAR(r.intervalos == 1);
+    VERIFICAR_PROXIMO(r.leq, 70.0, 0.01);
+    VERIFICAR(r.maximo == 71.0f);
+    VERIFICAR(r.l50 == 70.5f);
+    VERIFICAR(ag.dispositivos[agregador_buscar(&ag, "b")].perdidas == 0);
+    agregador_liberar(&ag);
+}
+
+// Lote do modo de baixo consumo: cada leitura vai para o intervalo em que foi medida
+static void testar_lote_atrasado(void) {
+    VERIFICAR(agregador_iniciar(&ag, 10));
+    VERIFICAR(enviar("c", "z", 1, 60.0f, 61.0f, 0, 1000.0));
+
+    // Medida há 35 s: intervalo de 960 s, já fechado
+    VERIFICAR(enviar("c", "z", 2, 80.0f, 82.0f, 35, 1001.0));
+    VERIFICAR(ag.atrasadas == 1);
+    agreg_resumo_t r = resumo_de("c");
+    VERIFICAR(r.intervalos == 1);
+    VERIFICAR_PROXIMO(r.leq, 80.0, 0.01);
+    VERIFICAR(r.maximo == 82.0f);
+
+    // Outra leitura do mesmo intervalo fechado: média da energia, maior máximo
+    VERIFICAR(enviar("c", "z", 3, 70.0f, 90.0f, 37, 1003.0));
+    VERIFICAR(ag.atrasadas == 2);
+    r = resumo_de("c");
+    VERIFICAR(r.intervalos == 1);
+    VERIFICAR_PROXIMO(r.leq, db((energia(80.0) + energia(70.0)) / 2.0), 0.01);
+    VERIFICAR(r.maximo == 90.0f);
+    VERIFICAR(r.l50 == 77.5f);
+
+    // Idade pequena: ainda no intervalo em andamento
+    VERIFICAR(enviar("c", "z", 4, 60.0f, 61.0f, 2, 1004.0));
+    VERIFICAR(ag.atrasadas == 2);
+    agregador_avancar(&ag, 1010.0);
+    r = resumo_de("c");
+    VERIFICAR(r.intervalos == 2);
+    VERIFICAR_PROXIMO(r.leq, db(((energia(80.0) + energia(70.0)) / 2.0 + energia(60.0)) / 2.0), 0.01);
+
+    // Mais antiga que a janela: descartada, sem mexer no resumo
+    uint64_t descartados = ag.descartados;
+    VERIFICAR(enviar("c", "z", 5, 100.0f, 100.0f, 10UL * AGREG_HISTORICO + 20, 1011.0));
+    VERIFICAR(ag.descartados == descartados + 1);
+    VERIFICAR(resumo_de("c").intervalos == 2);
+    agregador_liberar(&ag);
+}
+
+// Zona: energia média de todos os intervalos dos seus dispositivos e histogramas somados
+static void testar_zonas(void) {
+    VERIFICAR(agregador_iniciar(&ag, 10));
+    for (int i = 0; i < 10; i++) {
+        enviar("d1", "norte", (unsigned long)i + 1, 60.0f, 66.0f, 0, 10.0 * i);
+        if (i < 5) enviar("d2", "norte", (unsigned long)i + 1, 80.0f, 88.0f, 0, 10.0 * i);
+        enviar("d3", "sul", (unsigned long)i + 1, 40.0f, 45.0f, 0, 10.0 * i);
+    }
+    agregador_avancar(&ag, 100.0);
+
+    VERIFICAR(ag.num_zonas == 2);
+    int norte = agregador_buscar_zona(&ag, "norte");
+    int sul = agregador_buscar_zona(&ag, "sul");
+    VERIFICAR(norte >= 0 && sul >= 0 && norte != sul);
+    VERIFICAR(agregador_buscar_zona(&ag, "leste") == -1);
+
+    agreg_resumo_t r;
+    agregador_resumo_zona(&ag, norte, &r);
+    VERIFICAR(r.intervalos == 15);
+    VERIFICAR_PROXIMO(r.leq, db((10.0 * energia(60.0) + 5.0 * energia(80.0)) / 15.0), 0.01);
+    VERIFICAR(r.maximo == 88.0f);
+    VERIFICAR(r.l10 == 80.5f);
+    VERIFICAR(r.l50 == 60.5f);
+    VERIFICAR(r.l90 == 60.5f);
+
+    agregador_resumo_zona(&ag, sul, &r);
+    VERIFICAR(r.intervalos == 10);
+    VERIFICAR_PROXIMO(r.leq, 40.0, 0.01);
+    VERIFICAR(r.maximo == 45.0f);
+
+    // Sequência com lacuna conta leituras perdidas
+    enviar("d3", "sul", 20, 40.0f, 45.0f, 0, 100.0);
+    VERIFICAR(ag.dispositivos[agregador_buscar(&ag, "d3")].perdidas == 9);
+    agregador_liberar(&ag);
+}
+
+// Alarme perto do fundo de escala (~141 dB): os percentis não ficam presos no topo do histograma
+static void testar_fundo_de_escala(void) {
+    VERIFICAR(agregador_iniciar(&ag, 10));
+    for (int i = 0; i < 10; i++) enviar("e", "z", (unsigned long)i + 1, i < 5 ? 138.0f : 141.0f, 141.5f, 0, 10.0 * i);
+    agregador_avancar(&ag, 100.0);
+    agreg_resumo_t r = resumo_de("e");
+    VERIFICAR(r.l10 == 141.5f);
+    VERIFICAR(r.l90 == 138.5f);
+    VERIFICAR(r.maximo == 141.5f);
+    agregador_liberar(&ag);
+}
+
+int main(void) {
+    testar_alinhamento();
+    testar_anel();
+    testar_lote_atrasado();
+    testar_zonas();
+    testar_fundo_de_escala();
+    return TESTE_RESULTADO();
+}
@@ -0,0 +1,166 @@
+/*
+ * Descrição: Testes de lib/baixo_consumo.c no host. Um relógio simulado percorre o mesmo laço de
+ *            laco_baixo_consumo() em Monitor_Ruido.c (janela de 2 s a cada 10 s, lote de 30
+ *            janelas, envio de 1,5 s com o rádio fora do power-save) e confere a divisão do
+ *            tempo entre acordado, dormindo e rádio, o número de janelas e de lotes e a energia
+ *            do relatório de cada hora. Cobre também um envio mais longo que o período e os
+ *            limites da configuração.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "baixo_consumo.h"
+#include "teste.h"
+
+// Mesmos valores de Monitor_Ruido.c
+#define PERIODO_US   10000000ULL
+#define JANELA_US    2000000ULL
+#define LOTE         30
+#define ENVIO_US     1500000ULL     // Rádio fora do power-save enviando um lote
+#define SEGUNDO_US   1000000ULL
+
+static uint64_t agora_us = 0;
+static uint64_t relogio(void) { return agora_us; }
+
+static const baixo_consumo_config_t config = {
+    .periodo_us = PERIODO_US,
+    .janela_us = JANELA_US,
+    .janelas_por_lote = LOTE,
+    .corrente_acordado_ma = 25.0f,
+    .corrente_dormindo_ma = 12.0f,
+    .corrente_radio_ma = 45.0f,
+    .tensao_v = 3.3f,
+};
+
+static baixo_consumo_t bc;
+static int lotes_enviados = 0;
+
+// Energia esperada em mWh, normalizada para uma hora como no relatório
+static double energia_esperada(double acordado_s, double dormindo_s, double radio_s) {
+    double duracao_s = acordado_s + dormindo_s;
+    return 3.3 * (25.0 * acordado_s + 12.0 * dormindo_s + 45.0 * radio_s) / duracao_s;
+}
+
+// Uma volta do laço: mede a janela, envia o lote se encheu, tenta o relatório e dorme.
+// Retorna true se o relatório da hora saiu nesta volta.
+static bool volta(uint64_t envio_us, baixo_consumo_contas_t *contas) {
+    uint64_t fim = baixo_consumo_abrir_janela(&bc);
+    VERIFICAR(fim == agora_us + JANELA_US);
+    agora_us = fim;
+
+    float leq = 50.0f + (float)(bc.hora.janelas % 7);
+    if (baixo_consumo_fechar_janela(&bc, leq, leq + 10.0f)) {
+        baixo_consumo_radio(&bc, true);
+        const baixo_consumo_resultado_t *lote;
+        int n = baixo_consumo_lote(&bc, &lote);
+        VERIFICAR(n == LOTE);
+        // A última leitura é a da janela que acabou de fechar, com o instante do fechamento
+        VERIFICAR(lote[n - 1].leq == leq && lote[n - 1].maximo == leq + 10.0f);
+        VERIFICAR(lote[n - 1].instante_us == agora_us);
+        VERIFICAR(lote[0].instante_us < lote[n - 1].instante_us);
+        agora_us += envio_us;
+        baixo_consumo_esvaziar_lote(&bc);
+        baixo_consumo_radio(&bc, false);
+        lotes_enviados++;
+    }
+
+    bool relatorio = baixo_consumo_relatorio(&bc, contas);
+    uint64_t proxima = baixo_consumo_dormir(&bc);
+    VERIFICAR(proxima >= agora_us);
+    agora_us = proxima;
+    return relatorio;
+}
+
+// Uma hora no ciclo normal, e a seguinte já começando do fim do primeiro relatório
+static void testar_horas(void) {
+    agora_us = 0;
+    lotes_enviados = 0;
+    baixo_consumo_iniciar(&bc, &config, relogio);
+
+    baixo_consumo_contas_t contas;
+    int voltas = 0;
+    while (!volta(ENVIO_US, &contas)) voltas++;
+    voltas++;
+
+    // O relatório sai no fim da janela que começa em 3600 s: 361 janelas e 12 lotes em 3602 s
+    uint64_t duracao = contas.acordado_us + contas.dormindo_us;
+    printf("Hora 1: acordado %.1f s | dormindo %.1f s | rádio %.1f s | %u janelas | %u lotes | %.2f mWh\n",
+           contas.acordado_us / 1e6, contas.dormindo_us / 1e6, contas.radio_us / 1e6,
+           (unsigned)contas.janelas, (unsigned)contas.lotes, contas.energia_mwh);
+    VERIFICAR(voltas == 361);
+    VERIFICAR(contas.janelas == 361);
+    VERIFICAR(contas.lotes == 12);
+    VERIFICAR(lotes_enviados == 12);
+    VERIFICAR(duracao == 3602 * SEGUNDO_US);
+    VERIFICAR(contas.acordado_us == 361 * JANELA_US + 12 * ENVIO_US);
+    VERIFICAR(contas.radio_us == 12 * ENVIO_US);
+    VERIFICAR(contas.dormindo_us == duracao - contas.acordado_us);
+    VERIFICAR_PROXIMO(contas.energia_mwh, energia_esperada(740.0, 2862.0, 18.0), 0.01);
+
+    // Ciclo de trabalho ~20% e energia bem abaixo de ficar acordado a hora toda
+    VERIFICAR_PROXIMO((double)contas.acordado_us / duracao, 0.2, 0.01);
+    VERIFICAR(contas.energia_mwh < 3.3f * 25.0f);
+
+    // Segunda hora: de 3602 s a 7202 s, 360 janelas e mais 12 lotes (o lote não zera na virada)
+    voltas = 0;
+    while (!volta(ENVIO_US, &contas)) voltas++;
+    voltas++;
+    duracao = contas.acordado_us + contas.dormindo_us;
+    VERIFICAR(voltas == 360);
+    VERIFICAR(contas.janelas == 360);
+    VERIFICAR(contas.lotes == 12);
+    VERIFICAR(duracao == 3600 * SEGUNDO_US);
+    VERIFICAR(contas.radio_us == 12 * ENVIO_US);
+    VERIFICAR_PROXIMO(contas.energia_mwh, energia_esperada(738.0, 2862.0, 18.0), 0.01);
+
+    // Antes de completar a hora não há relatório
+    VERIFICAR(!baixo_consumo_relatorio(&bc, &contas));
+}
+
+// Envio maior que o resto do período: a próxima janela começa logo, sem recuperar o atraso
+static void testar_envio_longo(void) {
+    agora_us = 5 * SEGUNDO_US;
+    baixo_consumo_iniciar(&bc, &config, relogio);
+
+    baixo_consumo_contas_t contas;
+    for (int i = 0; i < LOTE - 1; i++) volta(ENVIO_US, &contas);
+    uint64_t inicio_ultima = agora_us;
+    volta(9 * SEGUNDO_US, &contas);
+    VERIFICAR(agora_us == inicio_ultima + JANELA_US + 9 * SEGUNDO_US);
+
+    // A janela seguinte volta ao período normal a partir de onde começou
+    uint64_t inicio = agora_us;
+    volta(ENVIO_US, &contas);
+    VERIFICAR(agora_us == inicio + PERIODO_US);
+    VERIFICAR(bc.hora.radio_us == 9 * SEGUNDO_US);
+    VERIFICAR(bc.hora.acordado_us + bc.hora.dormindo_us == bc.ultimo_us - 5 * SEGUNDO_US);
+}
+
+// Janela maior que o período e lotes fora da faixa são limitados
+static void testar_limites(void) {
+    baixo_consumo_config_t c = config;
+    c.janela_us = 2 * PERIODO_US;
+    c.janelas_por_lote = 0;
+    baixo_consumo_iniciar(&bc, &c, relogio);
+    VERIFICAR(bc.config.janela_us == PERIODO_US);
+    VERIFICAR(bc.config.janelas_por_lote == 1);
+    VERIFICAR(baixo_consumo_fechar_janela(&bc, 50.0f, 60.0f));
+
+    c.janelas_por_lote = BAIXO_CONSUMO_LOTE_MAX + 10;
+    baixo_consumo_iniciar(&bc, &c, relogio);
+    VERIFICAR(bc.config.janelas_por_lote == BAIXO_CONSUMO_LOTE_MAX);
+    for (int i = 0; i < BAIXO_CONSUMO_LOTE_MAX - 1; i++) VERIFICAR(!baixo_consumo_fechar_janela(&bc, 50.0f, 60.0f));
+    VERIFICAR(baixo_consumo_fechar_janela(&bc, 50.0f, 60.0f));
+
+    // Rádio ligado duas vezes seguidas conta um lote só
+    baixo_consumo_radio(&bc, true);
+    baixo_consumo_radio(&bc, true);
+    VERIFICAR(bc.hora.lotes == 1);
+}
+
+int main(void) {
+    testar_horas();
+    testar_envio_longo();
+    testar_limites();
+    return TESTE_RESULTADO();
+}
@@ -0,0 +1,136 @@
+/*
+ * Descrição: Testes do cancelamento do tom do buzzer (lib/dsp_ruido.cpp) no host. Sinais
+ *            sintéticos de tom mais ruído gaussiano passam pela mesma cadeia de medição do
+ *            firmware, com e sem o cancelamento: seno puro, tom com 3 harmônicos (limitado em
+ *            banda) e a onda quadrada de 90% do PWM sem filtro anti-aliasing, cujos harmônicos
+ *            rebatidos caem ao lado da fundamental. Verifica também o modelo guardado entre dois
+ *            acionamentos, a recuperação depois de um salto de fase e o buzzer ligado sem som.
+ */
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+
+#include "dsp_ruido.h"
+#include "teste.h"
+
+#define BLOCOS_POR_SEGUNDO  (DSP_TAXA_HZ / DSP_AMOSTRAS_BLOCO)
+#define OFFSET_ADC          2048.0
+#define RUIDO_CONTAGENS     20.0    // Desvio padrão do ruído ambiente
+#define AMPLITUDE_TOM       300.0
+#define AMPLITUDE_QUADRADA  600.0   // Pico a pico, como o PWM chega ao ADC
+
+typedef enum { SEM_TOM, SENO, HARMONICOS, QUADRADA } tom_t;
+
+// Uma única contagem de amostras para o sinal e para a cadeia: a fase do tom segue contínua
+// do começo ao fim, como o PWM que não para entre um alarme e outro
+static uint64_t amostras = 0;
+static double fase_inicial = 0.37;  // Em voltas; um salto simula o PWM reiniciado
+
+static uint32_t semente = 2024;
+static double uniforme(void) {
+    semente = semente * 1664525u + 1013904223u;
+    return ((semente >> 8) + 0.5) / 16777216.0;
+}
+
+static double gaussiano(void) {
+    return sqrt(-2.0 * log(uniforme())) * cos(2.0 * M_PI * uniforme());
+}
+
+static double tom(tom_t tipo, double fase) {
+    switch (tipo) {
+    case SENO:
+        return AMPLITUDE_TOM * sin(2.0 * M_PI * fase);
+    case HARMONICOS: {
+        // Os 3 primeiros harmônicos de uma quadrada de 90%
+        double v = 0.0;
+        for (int k = 1; k <= 3; k++) v += AMPLITUDE_TOM * sin(M_PI * 0.9 * k) / k * cos(2.0 * M_PI * k * fase);
+        return v;
+    }
+    case QUADRADA:
+        return fase - floor(fase) < 0.9 ? AMPLITUDE_QUADRADA * 0.1 : -AMPLITUDE_QUADRADA * 0.9;
+    default:
+        return 0.0;
+    }
+}
+
+// Processa um bloco de 10 ms e retorna o nível em dB SPL
+static float bloco(tom_t tipo, bool cancelar) {
+    uint16_t adc[DSP_AMOSTRAS_BLOCO];
+    for (int i = 0; i < DSP_AMOSTRAS_BLOCO; i++, amostras++) {
+        double fase = fase_inicial + (double)amostras * DSP_BUZZER_FREQUENCIA_HZ / DSP_TAXA_HZ;
+        double v = OFFSET_ADC + tom(tipo, fase) + RUIDO_CONTAGENS * gaussiano();
+        adc[i] = (uint16_t)(v < 0.0 ? 0.0 : (v > 4095.0 ? 4095.0 : v));
+    }
+    dsp_cancelar_buzzer(cancelar);
+    return dsp_processar_bloco(adc, NULL);
+}
+
+// Nível médio (em potência) de um trecho, descartando os primeiros blocos. Conta os blocos em
+// que o cancelamento aumentou a potência em mais de 1 dB (cada um descarta o modelo).
+static float trecho(tom_t tipo, bool cancelar, int blocos, int descartados, int *piores) {
+    double soma = 0.0;
+    for (int b = 0; b < blocos; b++) {
+        float db = bloco(tipo, cancelar);
+        if (piores && dsp_rejeicao_buzzer_db() < -1.0f) (*piores)++;
+        if (b >= descartados) soma += pow(10.0, db / 10.0);
+    }
+    return (float)(10.0 * log10(soma / (blocos - descartados)));
+}
+
+static float nivel_ruido;
+
+// Tom sem e com cancelamento: depois de 2 s a medição volta para perto do nível só do ruído
+static void testar_tom(const char *nome, tom_t tipo, float rejeicao_minima) {
+    float sem = trecho(tipo, false, BLOCOS_POR_SEGUNDO, 10, NULL);
+    int piores = 0;
+    float com = trecho(tipo, true, 3 * BLOCOS_POR_SEGUNDO, 2 * BLOCOS_POR_SEGUNDO, &piores);
+    float rejeicao = dsp_rejeicao_buzzer_db();
+    printf("%-11s: sem %.1f dB | com %.1f dB | ruído %.1f dB | rejeição %.1f dB | piores %d\n",
+           nome, sem, com, nivel_ruido, rejeicao, piores);
+    VERIFICAR(com <= nivel_ruido + 1.5f);
+    VERIFICAR(sem - com >= rejeicao_minima);
+    VERIFICAR(rejeicao > 0.0f);
+    VERIFICAR(piores <= 1);     // Só o bloco em que o modelo do tom anterior é descartado
+}
+
+// Entre dois acionamentos o modelo fica guardado: o tom é removido desde o primeiro bloco
+static void testar_novo_acionamento(void) {
+    trecho(SEM_TOM, false, 2 * BLOCOS_POR_SEGUNDO, 0, NULL);
+    float primeiro = bloco(QUADRADA, true);
+    float com = trecho(QUADRADA, true, BLOCOS_POR_SEGUNDO, 0, NULL);
+    printf("Religado   : primeiro bloco %.1f dB | 1 s %.1f dB\n", primeiro, com);
+    VERIFICAR(primeiro <= nivel_ruido + 2.0f);
+    VERIFICAR(com <= nivel_ruido + 1.5f);
+}
+
+// O PWM recomeça com outra fase: o primeiro bloco piora, o modelo é descartado e reaprendido
+static void testar_salto_de_fase(void) {
+    fase_inicial += 0.5;
+    int piores = 0;
+    float com = trecho(QUADRADA, true, 3 * BLOCOS_POR_SEGUNDO, 2 * BLOCOS_POR_SEGUNDO, &piores);
+    printf("Salto fase : piores %d | depois de 2 s %.1f dB\n", piores, com);
+    VERIFICAR(piores == 1);
+    VERIFICAR(com <= nivel_ruido + 1.5f);
+}
+
+// Buzzer ligado sem chegar ao microfone: o cancelamento quase não mexe no nível
+static void testar_sem_som(void) {
+    float com = trecho(SEM_TOM, true, 3 * BLOCOS_POR_SEGUNDO, BLOCOS_POR_SEGUNDO, NULL);
+    printf("Sem som    : com %.1f dB | ruído %.1f dB\n", com, nivel_ruido);
+    VERIFICAR(com <= nivel_ruido + 0.5f);
+}
+
+int main(void) {
+    // Acomoda o bloqueador de DC e os filtros antes de medir o nível do ruído sozinho
+    trecho(SEM_TOM, false, BLOCOS_POR_SEGUNDO, 0, NULL);
+    nivel_ruido = trecho(SEM_TOM, false, 2 * BLOCOS_POR_SEGUNDO, 0, NULL);
+    VERIFICAR(dsp_rejeicao_buzzer_db() == 0.0f);
+
+    testar_tom("Seno", SENO, 15.0f);
+    testar_tom("Harmônicos", HARMONICOS, 10.0f);
+    testar_tom("Quadrada", QUADRADA, 15.0f);
+    testar_novo_acionamento();
+    testar_salto_de_fase();
+    testar_sem_som();
+    return TESTE_RESULTADO();
+}
@@ -0,0 +1,183 @@
+/*
+ * Descrição: Testes de lib/captura_audio.c no host, sobre um SDK do Pico falso que entrega as
+ *            amostras pela interrupção do FIFO do ADC. Grava trechos de um tom com ruído e
+ *            verifica a compressão em etapas (o trecho só fica válido depois da última, mesmo com
+ *            amostras chegando entre elas), o alinhamento do disparo no trecho, a escolha do slot
+ *            mais antigo e as reservas de download: dois envios simultâneos do mesmo trecho, e o
+ *            trecho só volta a ser sobrescrito depois que o último envio termina.
+ */
+#define _DEFAULT_SOURCE
+
+#include <stdint.h>
+#include <string.h>
+
+#include "captura_audio.h"
+#include "hardware/adc.h"
+#include "pico/stdlib.h"
+#include "teste.h"
+
+#define OFFSET           2048
+#define ETAPAS           (CAPTURA_BLOCOS_POR_CLIP / 8)   // CAPTURA_BLOCOS_POR_ETAPA
+#define AMOSTRAS_TICK    80                              // Um bloco de 10 ms da tarefa de DSP
+
+static uint16_t trecho[CAPTURA_AMOSTRAS_CLIP];  // O que foi gravado no último trecho
+static int16_t decodificado[CAPTURA_AMOSTRAS_CLIP];
+static uint64_t amostras = 0;
+
+static uint32_t semente = 4242;
+static double aleatorio(void) {
+    semente = semente * 1664525u + 1013904223u;
+    return (semente >> 8) / 16777216.0 - 0.5;
+}
+
+// Tom de 440 Hz com ruído; guarda as amostras em "destino" se indicado
+static void alimentar(uint16_t *destino, int n) {
+    uint16_t bloco[AMOSTRAS_TICK];
+    while (n > 0) {
+        int k = n < AMOSTRAS_TICK ? n : AMOSTRAS_TICK;
+        for (int i = 0; i < k; i++, amostras++) {
+            double v = OFFSET + 800.0 * sin(2.0 * M_PI * 440.0 * amostras / CAPTURA_TAXA_HZ) + 30.0 * aleatorio();
+            bloco[i] = (uint16_t)v;
+        }
+        if (destino) {
+            memcpy(destino, bloco, k * sizeof(uint16_t));
+            destino += k;
+        }
+        falso_adc_amostras(bloco, k);
+        n -= k;
+    }
+}
+
+// Pré-disparo, disparo e pós-disparo: o anel fica congelado com exatamente "trecho"
+static uint32_t gravar(float nivel) {
+    alimentar(trecho, CAPTURA_AMOSTRAS_PRE);
+    uint32_t instante = to_ms_since_boot(get_absolute_time());
+    captura_disparar(nivel);
+    alimentar(trecho + CAPTURA_AMOSTRAS_PRE, CAPTURA_AMOSTRAS_POS);
+    return instante;
+}
+
+// Chama captura_processar() a cada tick de DSP até o trecho ser armazenado; retorna o número
+// de chamadas ou -1 se a captura voltou a ser armada sem armazenar nada
+static int processar(void) {
+    for (int chamadas = 1; chamadas <= 2 * ETAPAS; chamadas++) {
+        if (captura_processar()) return chamadas;
+        alimentar(NULL, AMOSTRAS_TICK);
+    }
+    return -1;
+}
+
+static int slot_da_sequencia(uint32_t sequencia) {
+    captura_info_t info;
+    for (int s = 0; s < CAPTURA_NUM_SLOTS; s++) {
+        if (captura_info(s, &info) && info.sequencia == sequencia) return s;
+    }
+    return -1;
+}
+
+// Primeiro trecho: 6 etapas, inválido até a última, e idêntico ao que foi gravado
+static void testar_etapas(void) {
+    uint32_t instante = gravar(133.0f);
+
+    captura_info_t info;
+    for (int e = 1; e < ETAPAS; e++) {
+        VERIFICAR(!captura_processar());
+        for (int s = 0; s < CAPTURA_NUM_SLOTS; s++) VERIFICAR(!captura_info(s, &info));
+        VERIFICAR(!captura_reservar(0));
+        alimentar(NULL, AMOSTRAS_TICK);     // Amostras novas não entram no anel congelado
+    }
+    VERIFICAR(captura_processar());
+    VERIFICAR(!captura_processar());        // Rearmada: nada mais a comprimir
+
+    int slot = slot_da_sequencia(1);
+    VERIFICAR(slot >= 0);
+    VERIFICAR(captura_info(slot, &info));
+    VERIFICAR(info.instante_ms == instante);
+    VERIFICAR(info.nivel_db == 133.0f);
+
+    // A primeira amostra de cada bloco vai sem compressão: confere o alinhamento exato
+    const uint8_t *dados = captura_dados(slot);
+    double sinal = 0.0, erro = 0.0;
+    for (int b = 0; b < CAPTURA_BLOCOS_POR_CLIP; b++) {
+        int16_t *saida = &decodificado[b * ADPCM_AMOSTRAS_POR_BLOCO];
+        adpcm_decodificar_bloco(&dados[b * ADPCM_BYTES_POR_BLOCO], saida);
+        VERIFICAR(saida[0] == captura_converter_amostra(trecho[b * ADPCM_AMOSTRAS_POR_BLOCO], OFFSET));
+    }
+    for (int i = 0; i < CAPTURA_AMOSTRAS_CLIP; i++) {
+        double original = captura_converter_amostra(trecho[i], OFFSET);
+        sinal += original * original;
+        erro += (decodificado[i] - original) * (decodificado[i] - original);
+    }
+    double snr = 10.0 * log10(sinal / erro);
+    printf("Trecho 1: SNR %.1f dB\n", snr);
+    VERIFICAR(snr > 25.0);
+
+    // Logo depois de rearmar não há pré-disparo: o disparo é ignorado
+    captura_disparar(140.0f);
+    alimentar(NULL, CAPTURA_AMOSTRAS_POS);
+    VERIFICAR(!captura_processar());
+}
+
+// Os slots livres são usados primeiro; depois, o trecho mais antigo é sobrescrito
+static void testar_slots(void) {
+    for (uint32_t sequencia = 2; sequencia <= CAPTURA_NUM_SLOTS; sequencia++) {
+        gravar(120.0f);
+        VERIFICAR(processar() == ETAPAS);
+        VERIFICAR(slot_da_sequencia(sequencia) >= 0);
+    }
+    VERIFICAR(slot_da_sequencia(1) >= 0);
+
+    int mais_antigo = slot_da_sequencia(1);
+    gravar(120.0f);
+    VERIFICAR(processar() == ETAPAS);
+    VERIFICAR(slot_da_sequencia(1) < 0);
+    VERIFICAR(slot_da_sequencia(CAPTURA_NUM_SLOTS + 1) == mais_antigo);
+}
+
+// Dois downloads do mesmo trecho: o segundo também é aceito, e o trecho fica protegido até o
+// último terminar
+static void testar_reservas(void) {
+    VERIFICAR(!captura_reservar(-1));
+    VERIFICAR(!captura_reservar(CAPTURA_NUM_SLOTS));
+
+    uint32_t proxima = CAPTURA_NUM_SLOTS + 2;
+    int disputado = slot_da_sequencia(proxima - CAPTURA_NUM_SLOTS);    // O mais antigo
+    VERIFICAR(disputado >= 0);
+    VERIFICAR(captura_reservar(disputado));
+    VERIFICAR(captura_reservar(disputado));
+
+    // Um envio termina: o outro ainda está lendo o slot
+    captura_liberar(disputado);
+    gravar(125.0f);
+    VERIFICAR(processar() == ETAPAS);
+    VERIFICAR(slot_da_sequencia(proxima - CAPTURA_NUM_SLOTS) == disputado);
+    VERIFICAR(slot_da_sequencia(proxima) != disputado);
+    proxima++;
+
+    // O último termina: o slot volta a ser o mais antigo disponível
+    captura_liberar(disputado);
+    captura_liberar(disputado);     // Liberação a mais não deixa o contador negativo
+    gravar(125.0f);
+    VERIFICAR(processar() == ETAPAS);
+    VERIFICAR(slot_da_sequencia(proxima) == disputado);
+    proxima++;
+
+    // Todos os slots em envio: o trecho é descartado e a captura volta a ser armada
+    for (int s = 0; s < CAPTURA_NUM_SLOTS; s++) VERIFICAR(captura_reservar(s));
+    gravar(125.0f);
+    VERIFICAR(processar() == -1);
+    VERIFICAR(slot_da_sequencia(proxima) < 0);
+    for (int s = 0; s < CAPTURA_NUM_SLOTS; s++) captura_liberar(s);
+
+    gravar(125.0f);
+    VERIFICAR(processar() == ETAPAS);
+    VERIFICAR(slot_da_sequencia(proxima) >= 0);
+}
+
+int main(void) {
+    captura_iniciar(OFFSET);
+    testar_etapas();
+    testar_slots();
+    testar_reservas();
+    return TESTE_RESULTADO();
+}
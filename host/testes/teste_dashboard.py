@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Testa tools/gerar_dashboard.py: ida e volta do gzip e estabilidade do ETag.
+
+Uso: teste_dashboard.py <raiz do repositório>
+
+Gera o cabeçalho duas vezes a partir de web/dashboard.html e confere que a saída é idêntica
+(ETag reprodutível), que o array descomprime exatamente para o HTML minificado, que o ETag
+é o SHA-1 do conteúdo comprimido e que ele muda quando a página muda.
+"""
+import gzip
+import hashlib
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+falhas = 0
+
+
+def verificar(condicao, descricao):
+    global falhas
+    if not condicao:
+        print('FALHOU:', descricao)
+        falhas += 1
+
+
+def gerar(gerador, entrada, saida):
+    subprocess.run([sys.executable, gerador, entrada, saida], check=True)
+    with open(saida, encoding='utf-8') as f:
+        texto = f.read()
+    etag = re.search(r'#define DASHBOARD_ETAG "\\"([0-9a-f]+)\\""', texto).group(1)
+    tamanho = int(re.search(r'#define DASHBOARD_TAMANHO (\d+)', texto).group(1))
+    corpo = texto[texto.index('dashboard_gz[DASHBOARD_TAMANHO] = {'):]
+    dados = bytes(int(b, 16) for b in re.findall(r'0x([0-9a-f]{2})', corpo))
+    return texto, etag, tamanho, dados
+
+
+def main():
+    raiz = sys.argv[1] if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), '..', '..')
+    gerador = os.path.join(raiz, 'tools', 'gerar_dashboard.py')
+    pagina = os.path.join(raiz, 'web', 'dashboard.html')
+    sys.dont_write_bytecode = True
+    sys.path.insert(0, os.path.join(raiz, 'tools'))
+    from gerar_dashboard import minificar
+
+    with open(pagina, encoding='utf-8') as f:
+        original = f.read()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        texto1, etag1, tamanho, dados = gerar(gerador, pagina, os.path.join(tmp, 'a.h'))
+        texto2, etag2, _, _ = gerar(gerador, pagina, os.path.join(tmp, 'b.h'))
+
+        verificar(texto1 == texto2, 'duas gerações da mesma página diferem')
+        verificar(etag1 == etag2, 'ETag instável')
+        verificar(len(dados) == tamanho, 'DASHBOARD_TAMANHO não bate com o array')
+        verificar(dados[:2] == b'\x1f\x8b', 'array não é gzip')
+        verificar(gzip.decompress(dados) == minificar(original).encode('utf-8'),
+                  'gzip não volta ao HTML minificado')
+        verificar(etag1 == hashlib.sha1(dados).hexdigest()[:16], 'ETag não é o SHA-1 do conteúdo')
+        verificar(len(dados) < len(original.encode('utf-8')) // 2, 'compressão abaixo do esperado')
+
+        # Qualquer mudança na página precisa invalidar o cache do navegador
+        alterada = os.path.join(tmp, 'alterada.html')
+        with open(alterada, 'w', encoding='utf-8') as f:
+            f.write(original.replace('</body>', '<p>v2</p></body>'))
+        _, etag3, _, dados3 = gerar(gerador, alterada, os.path.join(tmp, 'c.h'))
+        verificar(etag3 != etag1, 'ETag não mudou com a página')
+        verificar(b'<p>v2</p>' in gzip.decompress(dados3), 'mudança não chegou ao array')
+
+    print('%s: %s' % (os.path.basename(__file__), 'FALHOU' if falhas else 'OK'))
+    return 1 if falhas else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
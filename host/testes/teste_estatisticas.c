@@ -0,0 +1,166 @@
+/*
+ * Descrição: Testes de lib/estatisticas.c no host. Compara L10/L50/L90 do histograma com a
+ *            ordenação exata de uma hora de níveis gravados (série sintética com fundo, variação
+ *            lenta e passagens de veículos, 100 níveis/s como a tarefa de DSP), verifica a
+ *            mesclagem dos minutos na hora, um intervalo de alarme na faixa de 130 a 140 dB e o
+ *            acúmulo de níveis fora da faixa nas classes extremas.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "estatisticas.h"
+#include "teste.h"
+
+#define NIVEIS_POR_MINUTO  6000     // 10 ms por nível
+#define MINUTOS            60
+#define TOLERANCIA         (ESTAT_RESOLUCAO / 2.0f + 1e-3f)
+
+static float niveis[NIVEIS_POR_MINUTO * MINUTOS];
+static float ordenados[NIVEIS_POR_MINUTO * MINUTOS];
+
+// Gerador determinístico para a série ser a mesma em toda execução
+static uint32_t semente = 12345;
+static float aleatorio(void) {
+    semente = semente * 1664525u + 1013904223u;
+    return (semente >> 8) / 16777216.0f;
+}
+
+static void gravar_hora(void) {
+    float evento = 0.0f;
+    for (int i = 0; i < NIVEIS_POR_MINUTO * MINUTOS; i++) {
+        float fundo = 88.0f + 6.0f * sinf(i * 2.0f * 3.14159265f / (NIVEIS_POR_MINUTO * 20));
+        if (evento <= 0.0f && aleatorio() < 0.0005f) evento = 30.0f + 15.0f * aleatorio();
+        float nivel = fundo + 3.0f * (aleatorio() - 0.5f) + evento;
+        evento = evento > 0.0f ? evento - 0.01f : 0.0f;
+        niveis[i] = nivel;
+    }
+}
+
+static int comparar(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Ln exato: o mesmo critério de posição do histograma, aplicado à sequência ordenada
+static float nivel_exato(const float *valores, int n, float percentual) {
+    memcpy(ordenados, valores, n * sizeof(float));
+    qsort(ordenados, n, sizeof(float), comparar);
+    float fracao = (100.0f - percentual) / 100.0f;
+    int posicao = (int)ceilf(fracao * n);
+    if (posicao < 1) posicao = 1;
+    if (posicao > n) posicao = n;
+    return ordenados[posicao - 1];
+}
+
+static void verificar_niveis(const estat_histograma_t *h, const float *valores, int n) {
+    estat_niveis_t ln;
+    estat_calcular_niveis(h, &ln);
+    VERIFICAR(ln.amostras == (uint32_t)n);
+    VERIFICAR_PROXIMO(ln.l10, nivel_exato(valores, n, 10.0f), TOLERANCIA);
+    VERIFICAR_PROXIMO(ln.l50, nivel_exato(valores, n, 50.0f), TOLERANCIA);
+    VERIFICAR_PROXIMO(ln.l90, nivel_exato(valores, n, 90.0f), TOLERANCIA);
+    VERIFICAR_PROXIMO(ln.minimo, nivel_exato(valores, n, 100.0f), 0.0);
+    VERIFICAR_PROXIMO(ln.maximo, nivel_exato(valores, n, 0.0f), 0.0);
+}
+
+// Cada minuto e a hora mesclada a partir dos minutos contra a ordenação exata
+static void testar_minutos_e_hora(void) {
+    static estat_histograma_t minuto, hora;
+    estat_reset(&hora);
+    for (int m = 0; m < MINUTOS; m++) {
+        const float *inicio = niveis + m * NIVEIS_POR_MINUTO;
+        estat_reset(&minuto);
+        for (int i = 0; i < NIVEIS_POR_MINUTO; i++) estat_adicionar(&minuto, inicio[i]);
+        verificar_niveis(&minuto, inicio, NIVEIS_POR_MINUTO);
+        estat_mesclar(&hora, &minuto);
+    }
+    verificar_niveis(&hora, niveis, NIVEIS_POR_MINUTO * MINUTOS);
+}
+
+// Mesclar é o mesmo que acumular tudo num só histograma; origem vazia não altera o destino
+static void testar_mesclar(void) {
+    static estat_histograma_t a, b, tudo, vazio;
+    estat_reset(&a);
+    estat_reset(&b);
+    estat_reset(&tudo);
+    estat_reset(&vazio);
+    for (int i = 0; i < 1000; i++) {
+        float nivel = 70.0f + 70.0f * aleatorio();
+        estat_adicionar(i % 3 ? &a : &b, nivel);
+        estat_adicionar(&tudo, nivel);
+    }
+    estat_mesclar(&a, &vazio);
+    estat_mesclar(&a, &b);
+    VERIFICAR(a.total == tudo.total);
+    VERIFICAR(a.minimo == tudo.minimo);
+    VERIFICAR(a.maximo == tudo.maximo);
+    VERIFICAR(memcmp(a.classes, tudo.classes, sizeof(a.classes)) == 0);
+
+    // Destino vazio recebe mínimo e máximo da origem, não os zeros do reset
+    estat_mesclar(&vazio, &b);
+    VERIFICAR(vazio.minimo == b.minimo);
+    VERIFICAR(vazio.maximo == b.maximo);
+}
+
+// Alarme contínuo perto do fundo de escala: L10/L50/L90 acima dos limiares de 132 e 138 dB
+// seguem a ordenação exata, sem ficar presos no topo da faixa
+static void testar_faixa_alta(void) {
+    static estat_histograma_t h;
+    static float alarme[NIVEIS_POR_MINUTO];
+    estat_reset(&h);
+    for (int i = 0; i < NIVEIS_POR_MINUTO; i++) {
+        alarme[i] = 130.0f + 10.0f * aleatorio();
+        estat_adicionar(&h, alarme[i]);
+    }
+    VERIFICAR(h.classes[ESTAT_NUM_CLASSES - 1] == 0);
+    verificar_niveis(&h, alarme, NIVEIS_POR_MINUTO);
+
+    estat_niveis_t ln;
+    estat_calcular_niveis(&h, &ln);
+    printf("Alarme: L10 %.2f | L50 %.2f | L90 %.2f dB\n", ln.l10, ln.l50, ln.l90);
+    VERIFICAR(ln.l10 > 138.0f);
+    VERIFICAR(ln.l50 > 134.0f && ln.l50 < 136.0f);
+    VERIFICAR(ln.l90 > 130.0f && ln.l90 < 132.0f);
+}
+
+// Níveis fora de 60..145 dB caem nas classes extremas, e o Ln fica limitado a mínimo/máximo
+static void testar_fora_da_faixa(void) {
+    static estat_histograma_t h;
+    estat_reset(&h);
+    VERIFICAR(estat_nivel_excedido(&h, 50.0f) == 0.0f);
+
+    for (int i = 0; i < 90; i++) estat_adicionar(&h, 100.0f);
+    for (int i = 0; i < 5; i++) estat_adicionar(&h, 40.0f);
+    for (int i = 0; i < 5; i++) estat_adicionar(&h, 200.0f);
+    VERIFICAR(h.classes[0] == 5);
+    VERIFICAR(h.classes[ESTAT_NUM_CLASSES - 1] == 5);
+    VERIFICAR(h.minimo == 40.0f);
+    VERIFICAR(h.maximo == 200.0f);
+    VERIFICAR_PROXIMO(estat_nivel_excedido(&h, 50.0f), 100.0f, TOLERANCIA);
+    VERIFICAR_PROXIMO(estat_nivel_excedido(&h, 0.0f), 144.95f, TOLERANCIA);
+
+    // Só abaixo da faixa: a classe 0 (60,05 dB) é limitada ao máximo medido
+    estat_reset(&h);
+    estat_adicionar(&h, 45.0f);
+    estat_adicionar(&h, 55.0f);
+    VERIFICAR(h.classes[0] == 2);
+    VERIFICAR(estat_nivel_excedido(&h, 10.0f) == 55.0f);
+    VERIFICAR(estat_nivel_excedido(&h, 90.0f) <= 55.0f);
+
+    // Só acima: a última classe é limitada ao mínimo medido
+    estat_reset(&h);
+    estat_adicionar(&h, 150.0f);
+    estat_adicionar(&h, 160.0f);
+    VERIFICAR(h.classes[ESTAT_NUM_CLASSES - 1] == 2);
+    VERIFICAR(estat_nivel_excedido(&h, 90.0f) == 150.0f);
+}
+
+int main(void) {
+    gravar_hora();
+    testar_minutos_e_hora();
+    testar_mesclar();
+    testar_faixa_alta();
+    testar_fora_da_faixa();
+    return TESTE_RESULTADO();
+}
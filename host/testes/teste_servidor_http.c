@@ -0,0 +1,246 @@
+/*
+ * Descrição: Testes de lib/servidor_http.c no host, sobre um lwIP falso (lwip_falso/) em que
+ *            o teste controla tcp_sndbuf() e as confirmações. Verifica que um corpo maior que
+ *            TCP_SND_BUF sai em partes de até TCP_MSS conforme tcp_sent() confirma os dados,
+ *            keep-alive com pipelining, recusa com o pool esgotado, expiração por ociosidade,
+ *            nova tentativa após ERR_MEM e que nenhuma conexão fica presa no final.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lwip/tcp.h"
+#include "servidor_http.h"
+#include "teste.h"
+
+#define TAMANHO_GRANDE  20000       // Maior que TCP_SND_BUF (11680)
+#define PREFIXO         "PREFIXO-DO-ARQUIVO-COM-44-BYTES-0123456789ab"
+
+static uint8_t corpo_grande[TAMANHO_GRANDE];
+static int liberacoes = 0;
+
+static void liberar_grande(void *contexto) {
+    (void)contexto;
+    liberacoes++;
+}
+
+// Rotas de teste: /grande (prefixo + corpo estático), /pequeno (texto no buffer da conexão)
+// e qualquer outra sem resposta (o servidor responde 404)
+static void rota(servidor_http_conexao_t *conexao, const char *requisicao) {
+    if (strncmp(requisicao, "GET /grande ", 12) == 0) {
+        servidor_http_resposta_t r = {
+            .status = 200, .tipo = "application/octet-stream",
+            .prefixo = (const uint8_t *)PREFIXO, .tamanho_prefixo = sizeof(PREFIXO) - 1,
+            .corpo = corpo_grande, .tamanho_corpo = TAMANHO_GRANDE,
+            .liberar = liberar_grande,
+        };
+        servidor_http_responder(conexao, &r);
+    } else if (strncmp(requisicao, "GET /pequeno ", 13) == 0) {
+        char *corpo = servidor_http_corpo(conexao);
+        int n = snprintf(corpo, SERVIDOR_HTTP_CORPO_MAX, "ok");
+        servidor_http_resposta_t r = {
+            .status = 200, .tipo = "text/plain", .corpo = (const uint8_t *)corpo, .tamanho_corpo = n,
+        };
+        servidor_http_responder(conexao, &r);
+    }
+}
+
+static servidor_http_estatisticas_t estatisticas(void) {
+    servidor_http_estatisticas_t e;
+    servidor_http_estatisticas(&e);
+    return e;
+}
+
+// Confirma tudo o que estiver em voo, um segmento por vez
+static void confirmar_tudo(struct tcp_pcb *pcb) {
+    while (!pcb->fechado && !pcb->abortado && pcb->em_voo > 0) {
+        falso_confirmar(pcb, pcb->em_voo < TCP_MSS ? pcb->em_voo : TCP_MSS);
+    }
+}
+
+static int contar(const char *texto, u32_t tamanho, const char *padrao) {
+    int n = 0;
+    size_t p = strlen(padrao);
+    for (u32_t i = 0; i + p <= tamanho; i++) {
+        if (memcmp(texto + i, padrao, p) == 0) n++;
+    }
+    return n;
+}
+
+// Corpo maior que o buffer de envio: enche o buffer, depois avança um segmento por confirmação
+static void testar_envio_em_partes(void) {
+    for (int i = 0; i < TAMANHO_GRANDE; i++) corpo_grande[i] = (uint8_t)(i * 7 + i / 251);
+    liberacoes = 0;
+
+    struct tcp_pcb *pcb = falso_conectar();
+    VERIFICAR(pcb != NULL);
+    if (!pcb) return;
+    VERIFICAR(falso_enviar(pcb, "GET /grande HTTP/1.1\r\nHost: monitor\r\n\r\n") == ERR_OK);
+    VERIFICAR(pcb->recebidos_confirmados == strlen("GET /grande HTTP/1.1\r\nHost: monitor\r\n\r\n"));
+
+    // Primeira rodada: o buffer de envio enche e nada passa de um segmento
+    VERIFICAR(pcb->em_voo == TCP_SND_BUF);
+    VERIFICAR(tcp_sndbuf(pcb) == 0);
+    VERIFICAR(pcb->maior_escrita <= TCP_MSS);
+    VERIFICAR(pcb->saidas >= 1);
+    VERIFICAR(liberacoes == 0);
+
+    // Cada confirmação de um segmento libera exatamente um segmento novo enquanto houver dados
+    u32_t enviado_antes;
+    falso_saida(pcb, &enviado_antes);
+    int rodadas = 0;
+    while (pcb->em_voo > 0 && !pcb->fechado) {
+        u32_t escritas = pcb->escritas;
+        falso_confirmar(pcb, TCP_MSS < pcb->em_voo ? TCP_MSS : pcb->em_voo);
+        u32_t enviado;
+        falso_saida(pcb, &enviado);
+        VERIFICAR(pcb->em_voo <= TCP_SND_BUF);
+        if (enviado - enviado_antes > 0) {
+            VERIFICAR(enviado - enviado_antes <= TCP_MSS);
+            VERIFICAR(pcb->escritas == escritas + 1);
+        }
+        enviado_antes = enviado;
+        rodadas++;
+    }
+    VERIFICAR(pcb->maior_escrita == TCP_MSS);
+    VERIFICAR(rodadas > 1);
+
+    // Resposta completa e na ordem: cabeçalho, prefixo e corpo
+    u32_t tamanho;
+    const char *saida = falso_saida(pcb, &tamanho);
+    const char *fim_cabecalho = strstr(saida, "\r\n\r\n");
+    VERIFICAR(fim_cabecalho != NULL);
+    if (fim_cabecalho) {
+        u32_t cabecalho = (u32_t)(fim_cabecalho + 4 - saida);
+        VERIFICAR(strncmp(saida, "HTTP/1.1 200 OK\r\n", 17) == 0);
+        VERIFICAR(strstr(saida, "Content-Length: 20044\r\n") != NULL);
+        VERIFICAR(strstr(saida, "Connection: keep-alive\r\n") != NULL);
+        VERIFICAR(tamanho == cabecalho + sizeof(PREFIXO) - 1 + TAMANHO_GRANDE);
+        VERIFICAR(memcmp(saida + cabecalho, PREFIXO, sizeof(PREFIXO) - 1) == 0);
+        VERIFICAR(memcmp(saida + cabecalho + sizeof(PREFIXO) - 1, corpo_grande, TAMANHO_GRANDE) == 0);
+    }
+    // O corpo só é liberado depois da última confirmação, e a conexão continua aberta
+    VERIFICAR(liberacoes == 1);
+    VERIFICAR(!pcb->fechado);
+
+    falso_enviar(pcb, NULL);
+    VERIFICAR(pcb->fechado);
+}
+
+// Duas requisições no mesmo segmento: a segunda espera a primeira drenar e fecha a conexão
+static void testar_keep_alive(void) {
+    servidor_http_estatisticas_t antes = estatisticas();
+    struct tcp_pcb *pcb = falso_conectar();
+    VERIFICAR(pcb != NULL);
+    if (!pcb) return;
+    falso_enviar(pcb, "GET /pequeno HTTP/1.1\r\n\r\nGET /pequeno HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+    u32_t tamanho;
+    const char *saida = falso_saida(pcb, &tamanho);
+    VERIFICAR(contar(saida, tamanho, "HTTP/1.1 200") == 1);
+
+    confirmar_tudo(pcb);
+    saida = falso_saida(pcb, &tamanho);
+    VERIFICAR(contar(saida, tamanho, "HTTP/1.1 200") == 2);
+    VERIFICAR(contar(saida, tamanho, "Connection: keep-alive") == 1);
+    VERIFICAR(contar(saida, tamanho, "Connection: close") == 1);
+    VERIFICAR(pcb->fechado);
+
+    servidor_http_estatisticas_t depois = estatisticas();
+    VERIFICAR(depois.requisicoes - antes.requisicoes == 2);
+    VERIFICAR(depois.reutilizadas - antes.reutilizadas == 1);
+}
+
+// HTTP/1.0 sem keep-alive, rota inexistente e requisição maior que o buffer
+static void testar_erros(void) {
+    struct tcp_pcb *pcb = falso_conectar();
+    VERIFICAR(pcb != NULL);
+    if (!pcb) return;
+    falso_enviar(pcb, "GET /nada HTTP/1.0\r\n\r\n");
+    u32_t tamanho;
+    const char *saida = falso_saida(pcb, &tamanho);
+    VERIFICAR(strncmp(saida, "HTTP/1.1 404 Not Found\r\n", 24) == 0);
+    confirmar_tudo(pcb);
+    VERIFICAR(pcb->fechado);
+
+    pcb = falso_conectar();
+    VERIFICAR(pcb != NULL);
+    if (!pcb) return;
+    static char enorme[SERVIDOR_HTTP_REQUISICAO_MAX + 100];
+    memset(enorme, 'a', sizeof(enorme) - 1);
+    falso_enviar(pcb, enorme);
+    saida = falso_saida(pcb, &tamanho);
+    VERIFICAR(strncmp(saida, "HTTP/1.1 431 ", 13) == 0);
+    confirmar_tudo(pcb);
+    VERIFICAR(pcb->fechado);
+}
+
+// Pool cheio: a conexão seguinte é recusada (abortada) e as outras seguem atendidas
+static void testar_pool_esgotado(void) {
+    servidor_http_estatisticas_t antes = estatisticas();
+    struct tcp_pcb *abertas[SERVIDOR_HTTP_CONEXOES];
+    for (int i = 0; i < SERVIDOR_HTTP_CONEXOES; i++) {
+        abertas[i] = falso_conectar();
+        VERIFICAR(abertas[i] != NULL);
+    }
+    VERIFICAR(falso_conectar() == NULL);
+    VERIFICAR(estatisticas().recusadas - antes.recusadas == 1);
+    VERIFICAR(estatisticas().ativas == SERVIDOR_HTTP_CONEXOES);
+
+    for (int i = 0; i < SERVIDOR_HTTP_CONEXOES; i++) {
+        if (abertas[i]) falso_enviar(abertas[i], NULL);
+    }
+    VERIFICAR(estatisticas().ativas == 0);
+}
+
+// Sem atividade por SERVIDOR_HTTP_OCIOSO_MAX chamadas de poll a conexão é fechada
+static void testar_ociosa(void) {
+    servidor_http_estatisticas_t antes = estatisticas();
+    struct tcp_pcb *pcb = falso_conectar();
+    VERIFICAR(pcb != NULL);
+    if (!pcb) return;
+    VERIFICAR(pcb->pollinterval == SERVIDOR_HTTP_POLL_INTERVALO);
+    for (int i = 0; i < SERVIDOR_HTTP_OCIOSO_MAX - 1; i++) falso_poll(pcb);
+    VERIFICAR(!pcb->fechado);
+    falso_poll(pcb);
+    VERIFICAR(pcb->fechado);
+    VERIFICAR(estatisticas().expiradas - antes.expiradas == 1);
+}
+
+// tcp_write() sem memória: a resposta não se perde, o envio é retomado no poll
+static void testar_sem_memoria(void) {
+    struct tcp_pcb *pcb = falso_conectar();
+    VERIFICAR(pcb != NULL);
+    if (!pcb) return;
+    falso_falhar_escritas(1);
+    falso_enviar(pcb, "GET /pequeno HTTP/1.1\r\nConnection: close\r\n\r\n");
+    VERIFICAR(pcb->escritas == 0);
+    falso_poll(pcb);
+    VERIFICAR(pcb->escritas > 0);
+    confirmar_tudo(pcb);
+    u32_t tamanho;
+    const char *saida = falso_saida(pcb, &tamanho);
+    VERIFICAR(tamanho > 2 && memcmp(saida + tamanho - 2, "ok", 2) == 0);
+    VERIFICAR(pcb->fechado);
+}
+
+int main(void) {
+    VERIFICAR(servidor_http_iniciar(80, rota));
+    testar_envio_em_partes();
+    testar_keep_alive();
+    testar_erros();
+    testar_pool_esgotado();
+    testar_ociosa();
+    testar_sem_memoria();
+
+    // Nenhuma conexão presa no servidor nem no lwIP
+    VERIFICAR(estatisticas().ativas == 0);
+    VERIFICAR(falso_pcbs_ativos() == 0);
+
+    char json[256];
+    int n = servidor_http_estatisticas_json(json, sizeof(json));
+    VERIFICAR(n == (int)strlen(json));
+    VERIFICAR(strstr(json, "{\"ativas\":0,\"max_ativas\":6,") == json);
+    return TESTE_RESULTADO();
+}
@@ -0,0 +1,230 @@
+/*
+ * Descrição: Testes de lib/ui.c no host, com uma saída simulada que guarda o buffer do quadro e
+ *            o conteúdo do display (só o que foi enviado). Verifica que um quadro sem mudanças
+ *            não desenha nada, que um dígito alterado custa 64 pixels e uma região do tamanho do
+ *            caractere, que a troca de tela redesenha tudo, que um valor maior que o widget é
+ *            cortado sem desenhar além dele e que o display sempre termina igual ao buffer.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "ui.h"
+#include "teste.h"
+
+#define LARGURA  128
+#define ALTURA   64
+#define PX_CARACTERE  (UI_CARACTERE_PX * UI_CARACTERE_PX)
+
+enum { TELA_A, TELA_B, NUM_TELAS };
+
+// Cada pixel guarda o caractere que o cobre: basta para comparar buffer e display
+typedef struct {
+    char buffer[ALTURA][LARGURA];
+    char display[ALTURA][LARGURA];
+    uint32_t caracteres;
+    uint32_t limpezas;
+    uint32_t envios;
+    uint8_t regiao[4];      // Última região enviada (x0, y0, x1, y1)
+} saida_falsa_t;
+
+static void falsa_caractere(void *contexto, char c, uint8_t x, uint8_t y) {
+    saida_falsa_t *s = contexto;
+    for (int j = 0; j < UI_CARACTERE_PX; j++) {
+        for (int i = 0; i < UI_CARACTERE_PX; i++) s->buffer[y + j][x + i] = c;
+    }
+    s->caracteres++;
+}
+
+static void falsa_limpar(void *contexto) {
+    saida_falsa_t *s = contexto;
+    memset(s->buffer, 0, sizeof(s->buffer));
+    s->limpezas++;
+}
+
+static void falsa_enviar(void *contexto, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    saida_falsa_t *s = contexto;
+    for (int y = y0; y <= y1; y++) memcpy(&s->display[y][x0], &s->buffer[y][x0], x1 - x0 + 1);
+    s->envios++;
+    s->regiao[0] = x0;
+    s->regiao[1] = y0;
+    s->regiao[2] = x1;
+    s->regiao[3] = y1;
+}
+
+static saida_falsa_t falsa;
+static ui_t ui;
+static int nivel, buzzer, rede;
+
+// Texto visível no display na posição do valor de um widget
+static int display_mostra(int widget, const char *texto) {
+    const ui_widget_t *w = &ui.widgets[widget];
+    size_t n = strlen(texto);
+    for (size_t i = 0; i < n; i++) {
+        if (falsa.display[w->y][w->x_valor + i * UI_CARACTERE_PX] != texto[i]) return 0;
+    }
+    return 1;
+}
+
+// Desenha um quadro e confere que tudo o que foi rasterizado chegou ao display
+static void quadro(void) {
+    falsa.caracteres = 0;
+    falsa.limpezas = 0;
+    falsa.envios = 0;
+    ui_desenhar(&ui);
+    VERIFICAR(memcmp(falsa.buffer, falsa.display, sizeof(falsa.buffer)) == 0);
+    VERIFICAR(ui.regioes_quadro == falsa.envios);
+}
+
+static void configurar(void) {
+    ui_saida_t saida = {
+        .caractere = falsa_caractere, .limpar = falsa_limpar, .enviar = falsa_enviar,
+        .contexto = &falsa, .largura = LARGURA, .altura = ALTURA,
+    };
+    ui_iniciar(&ui, &saida, NUM_TELAS);
+    nivel = ui_adicionar(&ui, TELA_A, 10, 8, "dB SPL  ", 5);
+    buzzer = ui_adicionar(&ui, TELA_A, 10, 24, "Buzzer  ", 3);
+    rede = ui_adicionar(&ui, TELA_B, 0, 0, "IP ", 13);
+    VERIFICAR(nivel >= 0 && buzzer >= 0 && rede >= 0);
+
+    // Widgets que não cabem na tela ou telas inexistentes são recusados
+    VERIFICAR(ui_adicionar(&ui, TELA_A, 100, 0, "Longo", 2) == -1);
+    VERIFICAR(ui_adicionar(&ui, TELA_A, 0, 60, "", 1) == -1);
+    VERIFICAR(ui_adicionar(&ui, NUM_TELAS, 0, 0, "", 1) == -1);
+    VERIFICAR(ui_adicionar(&ui, TELA_A, 0, 0, "", UI_MAX_CARACTERES + 1) == -1);
+}
+
+// Primeiro quadro: limpa, desenha rótulos e valores da tela atual e envia o display inteiro
+static void testar_primeiro_quadro(void) {
+    ui_numero(&ui, nivel, "%.1f", 65.3f);
+    ui_texto(&ui, buzzer, "OFF");
+    ui_texto(&ui, rede, "192.168.0.10");
+    quadro();
+    VERIFICAR(falsa.limpezas == 1);
+    VERIFICAR(falsa.envios == 1);
+    VERIFICAR(falsa.regiao[0] == 0 && falsa.regiao[1] == 0);
+    VERIFICAR(falsa.regiao[2] == LARGURA - 1 && falsa.regiao[3] == ALTURA - 1);
+    uint32_t caracteres = 8 + 5 + 8 + 3;    // Rótulos e valores da tela A; nada da tela B
+    VERIFICAR(falsa.caracteres == caracteres);
+    VERIFICAR(ui.pixels_quadro == LARGURA * ALTURA + caracteres * PX_CARACTERE);
+    VERIFICAR(display_mostra(nivel, "65.3 "));
+    VERIFICAR(display_mostra(buzzer, "OFF"));
+}
+
+// Mesmos valores: nenhum pixel, nenhuma região
+static void testar_quadro_sem_mudanca(void) {
+    ui_numero(&ui, nivel, "%.1f", 65.3f);
+    ui_texto(&ui, buzzer, "OFF");
+    quadro();
+    VERIFICAR(ui.pixels_quadro == 0);
+    VERIFICAR(ui.regioes_quadro == 0);
+    VERIFICAR(falsa.caracteres == 0);
+}
+
+// Um dígito: 64 pixels e uma região exatamente do tamanho do caractere
+static void testar_um_digito(void) {
+    ui_numero(&ui, nivel, "%.1f", 65.4f);
+    quadro();
+    VERIFICAR(ui.pixels_quadro == PX_CARACTERE);
+    VERIFICAR(ui.regioes_quadro == 1);
+    const ui_widget_t *w = &ui.widgets[nivel];
+    uint8_t x = (uint8_t)(w->x_valor + 3 * UI_CARACTERE_PX);
+    VERIFICAR(falsa.regiao[0] == x && falsa.regiao[2] == x + UI_CARACTERE_PX - 1);
+    VERIFICAR(falsa.regiao[1] == w->y && falsa.regiao[3] == w->y + UI_CARACTERE_PX - 1);
+    VERIFICAR(display_mostra(nivel, "65.4 "));
+
+    // Dois dígitos separados no mesmo widget: dois caracteres, uma faixa do primeiro ao último
+    ui_numero(&ui, nivel, "%.1f", 75.5f);
+    quadro();
+    VERIFICAR(ui.pixels_quadro == 2 * PX_CARACTERE);
+    VERIFICAR(ui.regioes_quadro == 1);
+    VERIFICAR(falsa.regiao[0] == w->x_valor && falsa.regiao[2] == x + UI_CARACTERE_PX - 1);
+    VERIFICAR(display_mostra(nivel, "75.5 "));
+
+    // Um caractere em cada widget: uma região por widget
+    ui_numero(&ui, nivel, "%.1f", 75.6f);
+    ui_texto(&ui, buzzer, "ON");
+    quadro();
+    VERIFICAR(ui.pixels_quadro == 3 * PX_CARACTERE);   // "6", "N" e o espaço no lugar do "F"
+    VERIFICAR(ui.regioes_quadro == 2);
+    VERIFICAR(display_mostra(buzzer, "ON "));
+}
+
+// Troca de tela: redesenho completo da nova tela, e de novo completo ao voltar
+static void testar_troca_de_tela(void) {
+    // Mudanças em outra tela não são desenhadas
+    ui_texto(&ui, rede, "10.0.0.2");
+    quadro();
+    VERIFICAR(ui.pixels_quadro == 0);
+
+    ui_mudar_tela(&ui, TELA_B);
+    quadro();
+    VERIFICAR(falsa.limpezas == 1);
+    VERIFICAR(falsa.envios == 1);
+    VERIFICAR(falsa.caracteres == 3 + 13);
+    VERIFICAR(ui.pixels_quadro == LARGURA * ALTURA + (3 + 13) * PX_CARACTERE);
+    VERIFICAR(display_mostra(rede, "10.0.0.2     "));
+    VERIFICAR(falsa.display[ui.widgets[nivel].y][ui.widgets[nivel].x_valor] == 0);
+
+    // Pedir a tela atual não redesenha
+    ui_mudar_tela(&ui, TELA_B);
+    quadro();
+    VERIFICAR(ui.pixels_quadro == 0);
+
+    // A tela A volta inteira, mesmo com valores iguais aos desenhados antes
+    ui_proxima_tela(&ui);
+    quadro();
+    VERIFICAR(ui.tela == TELA_A);
+    VERIFICAR(falsa.limpezas == 1);
+    VERIFICAR(falsa.caracteres == 8 + 5 + 8 + 3);
+    VERIFICAR(ui.regioes_quadro == 1);
+    VERIFICAR(display_mostra(nivel, "75.6 "));
+    VERIFICAR(display_mostra(buzzer, "ON "));
+}
+
+static void testar_estatisticas(void) {
+    uint32_t quadros = ui.quadros;
+    uint64_t total = ui.pixels_total;
+    ui_numero(&ui, nivel, "%.1f", 75.7f);
+    quadro();
+    VERIFICAR(ui.quadros == quadros + 1);
+    VERIFICAR(ui.pixels_total == total + PX_CARACTERE);
+
+    ui_zerar_estatisticas(&ui);
+    VERIFICAR(ui.quadros == 0 && ui.pixels_total == 0);
+}
+
+// Valor maior que o widget: só os primeiros caracteres aparecem, e nada é desenhado depois
+// do fim do widget
+static void testar_truncamento(void) {
+    const ui_widget_t *w = &ui.widgets[buzzer];
+    uint8_t depois = (uint8_t)(w->x_valor + w->caracteres * UI_CARACTERE_PX);
+    ui_texto(&ui, buzzer, "LIGADO");
+    quadro();
+    VERIFICAR(memcmp(w->texto, "LIG", 3) == 0);
+    VERIFICAR(display_mostra(buzzer, "LIG"));
+    VERIFICAR(falsa.caracteres == 3);
+    VERIFICAR(falsa.buffer[w->y][depois] == 0);
+
+    // Número formatado com mais dígitos que o widget: o fim é cortado
+    ui_numero(&ui, nivel, "%.1f", 1234.5f);
+    quadro();
+    VERIFICAR(display_mostra(nivel, "1234."));
+    VERIFICAR(falsa.buffer[ui.widgets[nivel].y][ui.widgets[nivel].x_valor + 5 * UI_CARACTERE_PX] == 0);
+
+    // Mesmo texto longo de novo: o valor cortado não muda, nada a desenhar
+    ui_texto(&ui, buzzer, "LIGADO");
+    ui_numero(&ui, nivel, "%.1f", 1234.5f);
+    quadro();
+    VERIFICAR(ui.pixels_quadro == 0);
+}
+
+int main(void) {
+    configurar();
+    testar_primeiro_quadro();
+    testar_quadro_sem_mudanca();
+    testar_um_digito();
+    testar_troca_de_tela();
+    testar_estatisticas();
+    testar_truncamento();
+    return TESTE_RESULTADO();
+}
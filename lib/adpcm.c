@@ -0,0 +1,99 @@
+#include "adpcm.h"
+
+// Tabelas padrão IMA/DVI
+static const int16_t tabela_passos[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t tabela_indices[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+// Atualiza preditor e índice a partir de um nibble (comum ao codificador e ao decodificador)
+static inline void aplicar_nibble(adpcm_estado_t *estado, uint8_t nibble) {
+    int32_t passo = tabela_passos[estado->indice];
+    int32_t diferenca = passo >> 3;
+    if (nibble & 4) diferenca += passo;
+    if (nibble & 2) diferenca += passo >> 1;
+    if (nibble & 1) diferenca += passo >> 2;
+
+    if (nibble & 8) estado->preditor -= diferenca;
+    else            estado->preditor += diferenca;
+    if (estado->preditor > 32767)  estado->preditor = 32767;
+    if (estado->preditor < -32768) estado->preditor = -32768;
+
+    estado->indice += tabela_indices[nibble];
+    if (estado->indice < 0)  estado->indice = 0;
+    if (estado->indice > 88) estado->indice = 88;
+}
+
+// Quantiza uma amostra em 4 bits em relação ao preditor atual
+static inline uint8_t codificar_amostra(adpcm_estado_t *estado, int16_t amostra) {
+    int32_t passo = tabela_passos[estado->indice];
+    int32_t diferenca = (int32_t)amostra - estado->preditor;
+    uint8_t nibble = 0;
+
+    if (diferenca < 0) {
+        nibble = 8;
+        diferenca = -diferenca;
+    }
+    if (diferenca >= passo) {
+        nibble |= 4;
+        diferenca -= passo;
+    }
+    passo >>= 1;
+    if (diferenca >= passo) {
+        nibble |= 2;
+        diferenca -= passo;
+    }
+    passo >>= 1;
+    if (diferenca >= passo) {
+        nibble |= 1;
+    }
+
+    aplicar_nibble(estado, nibble);
+    return nibble;
+}
+
+void adpcm_iniciar(adpcm_estado_t *estado) {
+    estado->preditor = 0;
+    estado->indice = 0;
+}
+
+// Codifica ADPCM_AMOSTRAS_POR_BLOCO amostras em um bloco de ADPCM_BYTES_POR_BLOCO bytes.
+// A primeira amostra vai sem compressão no cabeçalho; as demais são empacotadas com
+// o nibble menos significativo primeiro.
+void adpcm_codificar_bloco(adpcm_estado_t *estado, const int16_t *pcm, uint8_t *bloco) {
+    estado->preditor = pcm[0];
+    bloco[0] = (uint8_t)(pcm[0] & 0xFF);
+    bloco[1] = (uint8_t)((pcm[0] >> 8) & 0xFF);
+    bloco[2] = (uint8_t)estado->indice;
+    bloco[3] = 0;
+
+    for (int i = 1, j = 4; i < ADPCM_AMOSTRAS_POR_BLOCO; i += 2, j++) {
+        uint8_t baixo = codificar_amostra(estado, pcm[i]);
+        uint8_t alto = codificar_amostra(estado, pcm[i + 1]);
+        bloco[j] = (uint8_t)(baixo | (alto << 4));
+    }
+}
+
+// Decodifica um bloco de ADPCM_BYTES_POR_BLOCO bytes em ADPCM_AMOSTRAS_POR_BLOCO amostras
+void adpcm_decodificar_bloco(const uint8_t *bloco, int16_t *pcm) {
+    adpcm_estado_t estado;
+    estado.preditor = (int16_t)(bloco[0] | (bloco[1] << 8));
+    estado.indice = bloco[2] > 88 ? 88 : bloco[2];
+    pcm[0] = (int16_t)estado.preditor;
+
+    for (int i = 1, j = 4; i < ADPCM_AMOSTRAS_POR_BLOCO; i += 2, j++) {
+        aplicar_nibble(&estado, bloco[j] & 0x0F);
+        pcm[i] = (int16_t)estado.preditor;
+        aplicar_nibble(&estado, bloco[j] >> 4);
+        pcm[i + 1] = (int16_t)estado.preditor;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef ADPCM_H
+#define ADPCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// IMA-ADPCM 4:1 em ponto fixo, no formato de blocos usado por arquivos WAV (formato 0x11).
+// Cada bloco mono ocupa 256 bytes: cabeçalho de 4 bytes (preditor e índice) + 252 bytes de nibbles.
+#define ADPCM_BYTES_POR_BLOCO    256
+#define ADPCM_AMOSTRAS_POR_BLOCO 505
+
+// Estado do codificador; o índice do passo é mantido entre blocos
+typedef struct {
+    int32_t preditor;
+    int32_t indice;
+} adpcm_estado_t;
+
+void adpcm_iniciar(adpcm_estado_t *estado);
+void adpcm_codificar_bloco(adpcm_estado_t *estado, const int16_t *pcm, uint8_t *bloco);
+void adpcm_decodificar_bloco(const uint8_t *bloco, int16_t *pcm);
+
+#endif // ADPCM_H
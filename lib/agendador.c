@@ -0,0 +1,75 @@
+#include "agendador.h"
+#include <string.h>
+
+void agendador_iniciar(agendador_t *ag, agendador_relogio_t relogio) {
+    memset(ag, 0, sizeof(*ag));
+    ag->relogio = relogio;
+}
+
+// Registra uma tarefa periódica; a primeira liberação é imediata.
+// Retorna o índice da tarefa ou -1 se não houver espaço.
+int agendador_adicionar(agendador_t *ag, const char *nome, agendador_funcao_t funcao,
+                        void *contexto, uint64_t periodo_us) {
+    if (ag->num_tarefas >= AGENDADOR_MAX_TAREFAS || periodo_us == 0) return -1;
+
+    agendador_tarefa_t *t = &ag->tarefas[ag->num_tarefas];
+    memset(t, 0, sizeof(*t));
+    t->nome = nome;
+    t->funcao = funcao;
+    t->contexto = contexto;
+    t->periodo_us = periodo_us;
+    t->proximo_us = ag->relogio();
+    return ag->num_tarefas++;
+}
+
+// Executa todas as tarefas vencidas, sempre a de prazo mais cedo primeiro, e retorna
+// o instante (us) do próximo prazo para que o chamador durma até lá.
+uint64_t agendador_executar(agendador_t *ag) {
+    while (true) {
+        uint64_t agora = ag->relogio();
+
+        agendador_tarefa_t *vencida = NULL;
+        for (int i = 0; i < ag->num_tarefas; i++) {
+            agendador_tarefa_t *t = &ag->tarefas[i];
+            if (t->proximo_us <= agora && (!vencida || t->proximo_us < vencida->proximo_us)) {
+                vencida = t;
+            }
+        }
+
+        if (!vencida) {
+            uint64_t proximo = UINT64_MAX;
+            for (int i = 0; i < ag->num_tarefas; i++) {
+                if (ag->tarefas[i].proximo_us < proximo) proximo = ag->tarefas[i].proximo_us;
+            }
+            return proximo;
+        }
+
+        uint64_t jitter = agora - vencida->proximo_us;
+        vencida->funcao(vencida->contexto);
+        uint64_t fim = ag->relogio();
+
+        vencida->execucoes++;
+        vencida->jitter_soma_us += jitter;
+        if (jitter > vencida->jitter_max_us) vencida->jitter_max_us = jitter;
+        if (fim - agora > vencida->duracao_max_us) vencida->duracao_max_us = fim - agora;
+
+        // Mantém a grade de prazos fixa; liberações que já passaram são puladas e contadas
+        vencida->proximo_us += vencida->periodo_us;
+        if (vencida->proximo_us <= fim) {
+            uint64_t perdidos = (fim - vencida->proximo_us) / vencida->periodo_us + 1;
+            vencida->proximo_us += perdidos * vencida->periodo_us;
+            vencida->estouros += (uint32_t)perdidos;
+        }
+    }
+}
+
+void agendador_zerar_estatisticas(agendador_t *ag) {
+    for (int i = 0; i < ag->num_tarefas; i++) {
+        agendador_tarefa_t *t = &ag->tarefas[i];
+        t->execucoes = 0;
+        t->estouros = 0;
+        t->jitter_max_us = 0;
+        t->jitter_soma_us = 0;
+        t->duracao_max_us = 0;
+    }
+}
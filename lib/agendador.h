@@ -0,0 +1,41 @@
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Agendador cooperativo por prazos (sem tick fixo). Não depende do SDK do Pico:
+// o relógio é injetado, o que permite rodar a mesma lógica com um relógio simulado.
+#define AGENDADOR_MAX_TAREFAS 8
+
+typedef uint64_t (*agendador_relogio_t)(void);
+typedef void (*agendador_funcao_t)(void *contexto);
+
+// Tarefa periódica e suas estatísticas de execução
+typedef struct {
+    const char *nome;
+    agendador_funcao_t funcao;
+    void *contexto;
+    uint64_t periodo_us;
+    uint64_t proximo_us;       // Próximo prazo de liberação
+
+    uint32_t execucoes;
+    uint32_t estouros;         // Liberações puladas porque a execução chegou depois do prazo seguinte
+    uint64_t jitter_max_us;    // Maior atraso entre o prazo e o início da execução
+    uint64_t jitter_soma_us;
+    uint64_t duracao_max_us;
+} agendador_tarefa_t;
+
+typedef struct {
+    agendador_tarefa_t tarefas[AGENDADOR_MAX_TAREFAS];
+    int num_tarefas;
+    agendador_relogio_t relogio;
+} agendador_t;
+
+void agendador_iniciar(agendador_t *ag, agendador_relogio_t relogio);
+int agendador_adicionar(agendador_t *ag, const char *nome, agendador_funcao_t funcao,
+                        void *contexto, uint64_t periodo_us);
+uint64_t agendador_executar(agendador_t *ag);
+void agendador_zerar_estatisticas(agendador_t *ag);
+
+#endif // AGENDADOR_H
@@ -0,0 +1,90 @@
+#include "baixo_consumo.h"
+#include <string.h>
+
+// Soma o tempo decorrido desde a última chamada ao estado atual do núcleo e do rádio
+static void contabilizar(baixo_consumo_t *bc) {
+    uint64_t agora = bc->relogio();
+    uint64_t decorrido = agora - bc->ultimo_us;
+    if (bc->acordado) bc->hora.acordado_us += decorrido;
+    else bc->hora.dormindo_us += decorrido;
+    if (bc->radio) bc->hora.radio_us += decorrido;
+    bc->ultimo_us = agora;
+}
+
+void baixo_consumo_iniciar(baixo_consumo_t *bc, const baixo_consumo_config_t *config, baixo_consumo_relogio_t relogio) {
+    memset(bc, 0, sizeof(*bc));
+    bc->config = *config;
+    if (bc->config.janela_us > bc->config.periodo_us) bc->config.janela_us = bc->config.periodo_us;
+    if (bc->config.janelas_por_lote < 1) bc->config.janelas_por_lote = 1;
+    if (bc->config.janelas_por_lote > BAIXO_CONSUMO_LOTE_MAX) bc->config.janelas_por_lote = BAIXO_CONSUMO_LOTE_MAX;
+    bc->relogio = relogio;
+    bc->ultimo_us = relogio();
+    bc->inicio_hora_us = bc->ultimo_us;
+    bc->inicio_janela_us = bc->ultimo_us;
+    bc->acordado = true;
+}
+
+// Acorda para medir; retorna o instante em que a janela termina
+uint64_t baixo_consumo_abrir_janela(baixo_consumo_t *bc) {
+    contabilizar(bc);
+    bc->acordado = true;
+    bc->inicio_janela_us = bc->ultimo_us;
+    return bc->inicio_janela_us + bc->config.janela_us;
+}
+
+// Guarda o resultado da janela no lote; retorna true quando o lote está cheio e deve ser enviado
+bool baixo_consumo_fechar_janela(baixo_consumo_t *bc, float leq, float maximo) {
+    contabilizar(bc);
+    bc->hora.janelas++;
+    if (bc->num_lote < BAIXO_CONSUMO_LOTE_MAX) {
+        baixo_consumo_resultado_t *r = &bc->lote[bc->num_lote++];
+        r->leq = leq;
+        r->maximo = maximo;
+        r->instante_us = bc->ultimo_us;
+    }
+    return bc->num_lote >= bc->config.janelas_por_lote;
+}
+
+// Passa a dormir; retorna o início da próxima janela. Se o envio de um lote ocupou o período
+// inteiro, a próxima janela começa imediatamente em vez de tentar recuperar o atraso.
+uint64_t baixo_consumo_dormir(baixo_consumo_t *bc) {
+    contabilizar(bc);
+    bc->acordado = false;
+    uint64_t proxima = bc->inicio_janela_us + bc->config.periodo_us;
+    return proxima > bc->ultimo_us ? proxima : bc->ultimo_us;
+}
+
+void baixo_consumo_radio(baixo_consumo_t *bc, bool ligado) {
+    contabilizar(bc);
+    if (ligado && !bc->radio) bc->hora.lotes++;
+    bc->radio = ligado;
+}
+
+int baixo_consumo_lote(const baixo_consumo_t *bc, const baixo_consumo_resultado_t **resultados) {
+    *resultados = bc->lote;
+    return bc->num_lote;
+}
+
+void baixo_consumo_esvaziar_lote(baixo_consumo_t *bc) {
+    bc->num_lote = 0;
+}
+
+// Fecha a hora em andamento se ela já completou; retorna true e preenche "contas" nesse caso
+bool baixo_consumo_relatorio(baixo_consumo_t *bc, baixo_consumo_contas_t *contas) {
+    contabilizar(bc);
+    uint64_t duracao = bc->ultimo_us - bc->inicio_hora_us;
+    if (duracao < BAIXO_CONSUMO_HORA_US) return false;
+
+    // E = V * (I_acordado * t_acordado + I_dormindo * t_dormindo + I_radio * t_radio),
+    // escalada para uma hora porque o relatório sai um pouco depois da virada
+    const baixo_consumo_config_t *c = &bc->config;
+    double ma_us = c->corrente_acordado_ma * (double)bc->hora.acordado_us
+                 + c->corrente_dormindo_ma * (double)bc->hora.dormindo_us
+                 + c->corrente_radio_ma * (double)bc->hora.radio_us;
+    bc->hora.energia_mwh = (float)(c->tensao_v * ma_us / (double)duracao);
+
+    *contas = bc->hora;
+    memset(&bc->hora, 0, sizeof(bc->hora));
+    bc->inicio_hora_us = bc->ultimo_us;
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef BAIXO_CONSUMO_H
+#define BAIXO_CONSUMO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Modo de baixo consumo: mede em janelas a cada período, dorme entre elas e guarda os
+// resultados em lotes que só são enviados quando o lote enche (única hora em que o rádio sai
+// do power-save). Não depende do SDK do Pico: o relógio é injetado, como no agendador.
+#define BAIXO_CONSUMO_LOTE_MAX  64
+#define BAIXO_CONSUMO_HORA_US   3600000000ULL
+
+typedef uint64_t (*baixo_consumo_relogio_t)(void);
+
+typedef struct {
+    uint64_t periodo_us;            // Início de uma janela ao início da seguinte
+    uint64_t janela_us;             // Tempo medindo em cada período (ciclo de trabalho)
+    uint16_t janelas_por_lote;
+    // Modelo de consumo usado na estimativa de energia
+    float corrente_acordado_ma;     // Núcleo medindo (ADC + DSP)
+    float corrente_dormindo_ma;     // Núcleo em __wfe, ADC parado
+    float corrente_radio_ma;        // Acréscimo com o rádio fora do power-save
+    float tensao_v;
+} baixo_consumo_config_t;
+
+// Resultado de uma janela: Leq e máximo dos blocos medidos
+typedef struct {
+    float leq;
+    float maximo;
+    uint64_t instante_us;           // Fim da janela
+} baixo_consumo_resultado_t;
+
+// Contabilidade de tempo e energia de um período (normalmente uma hora)
+typedef struct {
+    uint64_t acordado_us;
+    uint64_t dormindo_us;
+    uint64_t radio_us;
+    uint32_t janelas;
+    uint32_t lotes;
+    float energia_mwh;              // Energia estimada, normalizada para uma hora
+} baixo_consumo_contas_t;
+
+typedef struct {
+    baixo_consumo_config_t config;
+    baixo_consumo_relogio_t relogio;
+    uint64_t inicio_janela_us;
+    bool acordado;
+    bool radio;
+    uint64_t ultimo_us;             // Último instante já contabilizado
+    uint64_t inicio_hora_us;
+    baixo_consumo_contas_t hora;    // Hora em andamento
+    baixo_consumo_resultado_t lote[BAIXO_CONSUMO_LOTE_MAX];
+    int num_lote;
+} baixo_consumo_t;
+
+void baixo_consumo_iniciar(baixo_consumo_t *bc, const baixo_consumo_config_t *config, baixo_consumo_relogio_t relogio);
+uint64_t baixo_consumo_abrir_janela(baixo_consumo_t *bc);
+bool baixo_consumo_fechar_janela(baixo_consumo_t *bc, float leq, float maximo);
+uint64_t baixo_consumo_dormir(baixo_consumo_t *bc);
+void baixo_consumo_radio(baixo_consumo_t *bc, bool ligado);
+int baixo_consumo_lote(const baixo_consumo_t *bc, const baixo_consumo_resultado_t **resultados);
+void baixo_consumo_esvaziar_lote(baixo_consumo_t *bc);
+bool baixo_consumo_relatorio(baixo_consumo_t *bc, baixo_consumo_contas_t *contas);
+
+#endif // BAIXO_CONSUMO_H
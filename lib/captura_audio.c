@@ -0,0 +1,275 @@
+#include "captura_audio.h"
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Janela sempre ativa, de onde a tarefa de DSP lê os blocos de medição. Precisa cobrir o maior
+// atraso da tarefa: um quadro inteiro do display por I2C (~23 ms) somado a uma etapa da
+// compressão. 2048 amostras (256 ms) deixam folga; amostras perdidas quebrariam a continuidade
+// da medição e a fase do cancelador do buzzer.
+#define RECENTES_TAMANHO 2048  // Potência de 2
+
+// Blocos ADPCM comprimidos por chamada de captura_processar() (~4k amostras): o trecho
+// inteiro (24k amostras) sai em 6 chamadas, sem segurar a tarefa de DSP de uma vez
+#define CAPTURA_BLOCOS_POR_ETAPA 8
+
+typedef enum {
+    CAPTURA_ARMADA,        // Gravando continuamente o pré-disparo
+    CAPTURA_POS_DISPARO,   // Disparo recebido, completando o pós-disparo
+    CAPTURA_CONGELADA      // Anel completo aguardando compressão
+} captura_estado_t;
+
+static volatile uint16_t recentes[RECENTES_TAMANHO];
+static volatile uint32_t recentes_escrita = 0;
+static uint32_t recentes_leitura = 0;
+static uint32_t indice_bloco = 0;
+
+// Anel com exatamente um trecho: ao congelar, a posição de escrita aponta para a amostra mais antiga
+static uint16_t anel[CAPTURA_AMOSTRAS_CLIP];
+static volatile uint32_t anel_escrita = 0;
+static volatile uint32_t anel_preenchidas = 0;
+static volatile uint32_t pos_restantes = 0;
+static volatile captura_estado_t estado = CAPTURA_ARMADA;
+
+static uint16_t offset_adc = 2048;
+static float nivel_disparo = 0.0f;
+static uint32_t instante_disparo = 0;
+static uint32_t total_disparos = 0;
+
+// Compressão em andamento do anel congelado (slot < 0: nenhuma)
+static int codificando_slot = -1;
+static int codificando_bloco = 0;
+static uint32_t codificando_leitura = 0;
+static adpcm_estado_t codificador;
+
+// Trechos comprimidos em RAM
+static uint8_t slots_dados[CAPTURA_NUM_SLOTS][CAPTURA_BYTES_CLIP];
+static captura_info_t slots_info[CAPTURA_NUM_SLOTS];
+static volatile uint8_t slots_envios[CAPTURA_NUM_SLOTS];   // Envios em andamento de cada trecho
+
+// Interrupção do FIFO do ADC: distribui as amostras entre a janela curta e o anel de pré-disparo
+static void adc_irq_handler(void) {
+    while (!adc_fifo_is_empty()) {
+        uint16_t valor = adc_fifo_get();
+
+        recentes[recentes_escrita & (RECENTES_TAMANHO - 1)] = valor;
+        recentes_escrita++;
+
+        if (estado == CAPTURA_CONGELADA) continue;
+
+        anel[anel_escrita] = valor;
+        if (++anel_escrita >= CAPTURA_AMOSTRAS_CLIP) anel_escrita = 0;
+        if (anel_preenchidas < CAPTURA_AMOSTRAS_CLIP) anel_preenchidas++;
+
+        if (estado == CAPTURA_POS_DISPARO && --pos_restantes == 0) {
+            estado = CAPTURA_CONGELADA;
+        }
+    }
+}
+
+// Configura o ADC em modo free-running a CAPTURA_TAXA_HZ, com interrupção a cada 4 amostras.
+// Deve ser chamada depois da calibração, pois adc_read() deixa de ser usado a partir daqui.
+void captura_iniciar(uint16_t offset) {
+    offset_adc = offset;
+
+    adc_select_input(CAPTURA_CANAL_ADC);
+    adc_fifo_setup(true, false, 4, false, false);
+    adc_set_clkdiv(48000000.0f / CAPTURA_TAXA_HZ - 1.0f); // Relógio do ADC: 48 MHz
+    adc_fifo_drain();
+
+    irq_set_exclusive_handler(ADC_IRQ_FIFO, adc_irq_handler);
+    adc_irq_set_enabled(true);
+    irq_set_enabled(ADC_IRQ_FIFO, true);
+    adc_run(true);
+}
+
+// Para o ADC entre janelas de medição (modo de baixo consumo) e o retoma. Ao retomar, as
+// amostras antigas da janela curta são descartadas para o próximo bloco ser contínuo.
+// O anel de pré-disparo não é zerado: um trecho logo após a retomada pode emendar janelas.
+void captura_pausar(bool pausar) {
+    if (pausar) {
+        adc_run(false);
+        adc_fifo_drain();
+    } else {
+        recentes_leitura = recentes_escrita;
+        adc_run(true);
+    }
+}
+
+// Média das últimas n amostras brutas do microfone (substitui as leituras com adc_read())
+uint16_t captura_media_recente(int n) {
+    if (n > RECENTES_TAMANHO) n = RECENTES_TAMANHO;
+    uint32_t fim = recentes_escrita;
+    uint32_t soma = 0;
+    for (int i = 1; i <= n; i++) {
+        soma += recentes[(fim - i) & (RECENTES_TAMANHO - 1)];
+    }
+    return n > 0 ? soma / n : 0;
+}
+
+// Copia o próximo bloco contínuo de n amostras da janela curta, se já estiver disponível.
+// Se o consumidor atrasar mais que a janela, descarta o excesso e retoma do trecho mais novo.
+bool captura_ler_bloco(uint16_t *destino, int n) {
+    uint32_t escrita = recentes_escrita;
+    if (escrita - recentes_leitura > RECENTES_TAMANHO) {
+        recentes_leitura = escrita - RECENTES_TAMANHO;
+    }
+    if (n > RECENTES_TAMANHO || escrita - recentes_leitura < (uint32_t)n) return false;
+
+    indice_bloco = recentes_leitura;
+    for (int i = 0; i < n; i++) {
+        destino[i] = recentes[recentes_leitura & (RECENTES_TAMANHO - 1)];
+        recentes_leitura++;
+    }
+    return true;
+}
+
+// Índice (amostras desde captura_iniciar) da primeira amostra do último bloco lido
+uint32_t captura_indice_bloco(void) {
+    return indice_bloco;
+}
+
+// Sinaliza uma ultrapassagem do limiar extremo. Ignorado enquanto um trecho está sendo
+// concluído ou se ainda não há pré-disparo suficiente no anel.
+void captura_disparar(float nivel_db) {
+    if (estado != CAPTURA_ARMADA || anel_preenchidas < CAPTURA_AMOSTRAS_PRE) return;
+
+    nivel_disparo = nivel_db;
+    instante_disparo = to_ms_since_boot(get_absolute_time());
+    pos_restantes = CAPTURA_AMOSTRAS_POS;
+    estado = CAPTURA_POS_DISPARO;
+}
+
+// Remove o offset e escala os 12 bits do ADC para 16 bits. Com o offset calibrado abaixo de
+// 2048 uma amostra saturada passaria de 32767, então o resultado é limitado à faixa do int16.
+int16_t captura_converter_amostra(uint16_t adc, uint16_t offset) {
+    int32_t amostra = ((int32_t)adc - offset) * 16;
+    if (amostra > INT16_MAX) amostra = INT16_MAX;
+    if (amostra < INT16_MIN) amostra = INT16_MIN;
+    return (int16_t)amostra;
+}
+
+// Escolhe o slot livre ou, na falta dele, o trecho mais antigo que não esteja sendo enviado
+static int escolher_slot(void) {
+    int escolhido = -1;
+    for (int i = 0; i < CAPTURA_NUM_SLOTS; i++) {
+        if (slots_envios[i] > 0) continue;
+        if (!slots_info[i].valido) return i;
+        if (escolhido < 0 || slots_info[i].sequencia < slots_info[escolhido].sequencia) escolhido = i;
+    }
+    return escolhido;
+}
+
+// Chamada no laço principal: comprime o anel congelado em um slot, CAPTURA_BLOCOS_POR_ETAPA
+// blocos por chamada, e rearma a captura no fim. Retorna true quando um novo trecho foi armazenado.
+bool captura_processar(void) {
+    if (estado != CAPTURA_CONGELADA) return false;
+
+    if (codificando_slot < 0) {
+        // captura_reservar() roda nos callbacks do lwIP (interrupção): escolher e invalidar o slot
+        // precisa ser atômico para um envio não reservar o trecho que vai ser sobrescrito
+        uint32_t interrupcoes = save_and_disable_interrupts();
+        int slot = escolher_slot();
+        if (slot >= 0) slots_info[slot].valido = false;
+        restore_interrupts(interrupcoes);
+
+        if (slot < 0) {
+            // Todos os slots estão sendo enviados: o trecho é descartado
+            anel_preenchidas = 0;
+            estado = CAPTURA_ARMADA;
+            return false;
+        }
+        codificando_slot = slot;
+        codificando_bloco = 0;
+        codificando_leitura = anel_escrita; // Amostra mais antiga do anel
+        adpcm_iniciar(&codificador);
+    }
+
+    static int16_t pcm[ADPCM_AMOSTRAS_POR_BLOCO];
+    int fim = codificando_bloco + CAPTURA_BLOCOS_POR_ETAPA;
+    if (fim > CAPTURA_BLOCOS_POR_CLIP) fim = CAPTURA_BLOCOS_POR_CLIP;
+    for (; codificando_bloco < fim; codificando_bloco++) {
+        for (int i = 0; i < ADPCM_AMOSTRAS_POR_BLOCO; i++) {
+            pcm[i] = captura_converter_amostra(anel[codificando_leitura], offset_adc);
+            if (++codificando_leitura >= CAPTURA_AMOSTRAS_CLIP) codificando_leitura = 0;
+        }
+        adpcm_codificar_bloco(&codificador, pcm,
+                              &slots_dados[codificando_slot][codificando_bloco * ADPCM_BYTES_POR_BLOCO]);
+    }
+    if (codificando_bloco < CAPTURA_BLOCOS_POR_CLIP) return false;
+
+    int slot = codificando_slot;
+    slots_info[slot].instante_ms = instante_disparo;
+    slots_info[slot].nivel_db = nivel_disparo;
+    slots_info[slot].sequencia = ++total_disparos;
+    slots_info[slot].valido = true;
+    codificando_slot = -1;
+
+    // Rearma: o pré-disparo precisa ser preenchido novamente
+    anel_preenchidas = 0;
+    estado = CAPTURA_ARMADA;
+    return true;
+}
+
+bool captura_info(int slot, captura_info_t *info) {
+    if (slot < 0 || slot >= CAPTURA_NUM_SLOTS || !slots_info[slot].valido) return false;
+    *info = slots_info[slot];
+    return true;
+}
+
+const uint8_t *captura_dados(int slot) {
+    return slots_dados[slot];
+}
+
+static void escrever_u16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+}
+
+static void escrever_u32(uint8_t *p, uint32_t v) {
+    escrever_u16(p, v & 0xFFFF);
+    escrever_u16(p + 2, v >> 16);
+}
+
+// Monta o cabeçalho WAV IMA-ADPCM (formato 0x11) de um trecho; todos os trechos têm o mesmo tamanho
+size_t captura_cabecalho_wav(uint8_t *buffer) {
+    uint8_t *p = buffer;
+    memcpy(p, "RIFF", 4);
+    escrever_u32(p + 4, CAPTURA_TAMANHO_CABECALHO_WAV - 8 + CAPTURA_BYTES_CLIP);
+    memcpy(p + 8, "WAVE", 4);
+
+    memcpy(p + 12, "fmt ", 4);
+    escrever_u32(p + 16, 20);
+    escrever_u16(p + 20, 0x0011);                                  // IMA-ADPCM
+    escrever_u16(p + 22, 1);                                       // Mono
+    escrever_u32(p + 24, CAPTURA_TAXA_HZ);
+    escrever_u32(p + 28, CAPTURA_TAXA_HZ * ADPCM_BYTES_POR_BLOCO / ADPCM_AMOSTRAS_POR_BLOCO);
+    escrever_u16(p + 32, ADPCM_BYTES_POR_BLOCO);                   // Alinhamento do bloco
+    escrever_u16(p + 34, 4);                                       // Bits por amostra
+    escrever_u16(p + 36, 2);                                       // Bytes extras
+    escrever_u16(p + 38, ADPCM_AMOSTRAS_POR_BLOCO);
+
+    memcpy(p + 40, "fact", 4);
+    escrever_u32(p + 44, 4);
+    escrever_u32(p + 48, CAPTURA_AMOSTRAS_CLIP);
+
+    memcpy(p + 52, "data", 4);
+    escrever_u32(p + 56, CAPTURA_BYTES_CLIP);
+    return CAPTURA_TAMANHO_CABECALHO_WAV;
+}
+
+// Impede que um trecho seja sobrescrito enquanto é enviado pela rede. Cada envio reserva o
+// trecho uma vez: vários downloads simultâneos do mesmo trecho são permitidos, e ele só volta a
+// ser candidato a sobrescrita depois que o último chamar captura_liberar().
+bool captura_reservar(int slot) {
+    if (slot < 0 || slot >= CAPTURA_NUM_SLOTS || !slots_info[slot].valido) return false;
+    if (slots_envios[slot] == UINT8_MAX) return false;
+    slots_envios[slot]++;
+    return true;
+}
+
+void captura_liberar(int slot) {
+    if (slot >= 0 && slot < CAPTURA_NUM_SLOTS && slots_envios[slot] > 0) slots_envios[slot]--;
+}
@@ -0,0 +1,47 @@
+#ifndef CAPTURA_AUDIO_H
+#define CAPTURA_AUDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "adpcm.h"
+
+// Amostragem contínua do microfone (ADC2) em modo free-running
+#define CAPTURA_TAXA_HZ          8000
+#define CAPTURA_CANAL_ADC        2
+
+// Cada trecho tem ~3 s: 2 s antes do disparo e o restante depois dele
+#define CAPTURA_BLOCOS_POR_CLIP  48
+#define CAPTURA_AMOSTRAS_CLIP    (CAPTURA_BLOCOS_POR_CLIP * ADPCM_AMOSTRAS_POR_BLOCO)
+#define CAPTURA_AMOSTRAS_PRE     (2 * CAPTURA_TAXA_HZ)
+#define CAPTURA_AMOSTRAS_POS     (CAPTURA_AMOSTRAS_CLIP - CAPTURA_AMOSTRAS_PRE)
+#define CAPTURA_BYTES_CLIP       (CAPTURA_BLOCOS_POR_CLIP * ADPCM_BYTES_POR_BLOCO)
+#define CAPTURA_NUM_SLOTS        4
+
+// Tamanho do cabeçalho WAV (RIFF + fmt IMA-ADPCM + fact + data)
+#define CAPTURA_TAMANHO_CABECALHO_WAV 60
+
+// Informações de um trecho armazenado
+typedef struct {
+    bool valido;
+    uint32_t instante_ms;   // Momento do disparo (ms desde o boot)
+    float nivel_db;         // Nível que provocou o disparo
+    uint32_t sequencia;     // Número do disparo desde o boot
+} captura_info_t;
+
+void captura_iniciar(uint16_t offset);
+void captura_pausar(bool pausar);
+uint16_t captura_media_recente(int n);
+bool captura_ler_bloco(uint16_t *destino, int n);
+uint32_t captura_indice_bloco(void);
+void captura_disparar(float nivel_db);
+bool captura_processar(void);
+int16_t captura_converter_amostra(uint16_t adc, uint16_t offset);
+
+bool captura_info(int slot, captura_info_t *info);
+const uint8_t *captura_dados(int slot);
+size_t captura_cabecalho_wav(uint8_t *buffer);
+bool captura_reservar(int slot);
+void captura_liberar(int slot);
+
+#endif // CAPTURA_AUDIO_H
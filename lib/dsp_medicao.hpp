@@ -0,0 +1,67 @@
+/*
+ * Descrição: Cadeia de medição de nível do firmware, somente cabeçalho: coeficientes e a ordem
+ *            dos estágios de lib/dsp_pipeline.hpp. Usada por lib/dsp_ruido.cpp e pelo benchmark
+ *            do host (host/bench_dsp.cpp), para os dois medirem exatamente a mesma cadeia.
+ */
+#ifndef DSP_MEDICAO_HPP
+#define DSP_MEDICAO_HPP
+
+#include "dsp_pipeline.hpp"
+#include "dsp_ruido.h"
+
+namespace medicao {
+
+constexpr std::size_t FATOR_DECIMACAO = 2;
+
+// Polo do bloqueador de DC (~6 Hz a 8 kHz)
+struct CoefsDC {
+    static constexpr float r = 0.995f;
+};
+
+// Tom do próprio buzzer: frequência do PWM de emitir_som_buzzer(), onda quadrada de 90% com
+// todos os harmônicos rebatidos. Forma de onda em 1024 pontos por período (4 KB). Como 999 Hz
+// é quase 1/8 da taxa, a fase só volta ao mesmo ponto a cada ~125 ms: cada passo da partida
+// dura 3 dessas voltas. A medição fica a ~1 dB do nível sem o tom em ~1 s.
+struct CoefsBuzzer {
+    static constexpr double frequencia = DSP_BUZZER_FREQUENCIA_HZ;
+    static constexpr double taxa = DSP_TAXA_HZ;
+    static constexpr int bits_modelo = 10;
+    static constexpr int passo = 3;
+    static constexpr std::size_t blocos_por_passo = 40;
+    static constexpr int escala = 4; // Contagens do ADC em Q4
+};
+
+// Limitação de banda: passa-altas de 30 Hz e passa-baixas de 3,4 kHz (Butterworth, fs = 8 kHz)
+struct CoefsBanda {
+    static constexpr dsp::SecaoBiquad secoes[] = {
+        { 0.98347720f, -1.96695441f, 0.98347720f, -1.96668139f, 0.96722743f },
+        { 0.71573741f,  1.43147482f, 0.71573741f,  1.34896775f, 0.51398189f },
+    };
+};
+
+// Mesma calibração usada antes em convertToDBSPL(): ADC de 12 bits a 3,3 V,
+// microfone de 7 mV/Pa e referência de 20 µPa
+struct CoefsCalibracao {
+    static constexpr float volts_por_contagem = 3.3f / 4095.0f;
+    static constexpr float sensibilidade = 0.007f;
+    static constexpr float referencia = 20e-6f;
+};
+
+using DC = dsp::BloqueadorDC<float, CoefsDC>;
+using Buzzer = dsp::CanceladorTom<float, CoefsBuzzer>;
+using Banda = dsp::CascataBiquad<float, CoefsBanda>;
+using Decimacao = dsp::Decimador<float, FATOR_DECIMACAO>;
+using RMS = dsp::IntegradorRMS<float, DSP_AMOSTRAS_BLOCO / FATOR_DECIMACAO>;
+using DB = dsp::ConversorDB<float, CoefsCalibracao>;
+
+// O valor quadrático médio de um sinal de banda larga se mantém ao descartar amostras,
+// então o RMS é estimado a 4 kHz com metade do custo
+using Cadeia = dsp::Pipeline<float, DSP_AMOSTRAS_BLOCO, DC, Buzzer, Banda, Decimacao, RMS, DB>;
+
+// Posição dos estágios consultados fora da cadeia
+constexpr std::size_t ESTAGIO_BUZZER = 1;
+constexpr std::size_t ESTAGIO_RMS = 4;
+
+} // namespace medicao
+
+#endif // DSP_MEDICAO_HPP
@@ -0,0 +1,267 @@
+/*
+ * Descrição: Estágios de processamento de sinal em C++17, somente cabeçalho.
+ *            Cada estágio é um template especializado em tempo de compilação (tipo da amostra,
+ *            tamanho do bloco e coeficientes constexpr) e a composição gera um único laço por
+ *            bloco, sem alocação dinâmica.
+ *
+ * Interface de um estágio:
+ *   bool passo(T &x)      - processa uma amostra; retorna false se ela não segue adiante
+ *   bool fim_bloco(T &x)  - chamado uma vez ao fim do bloco; estágios de bloco (RMS, dB)
+ *                           escrevem o resultado em x, os demais apenas repassam
+ */
+#ifndef DSP_PIPELINE_HPP
+#define DSP_PIPELINE_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+namespace dsp {
+
+// Coeficientes de uma seção biquad (forma direta II transposta, a0 normalizado em 1)
+struct SecaoBiquad {
+    float b0, b1, b2, a1, a2;
+};
+
+// Bloqueador de DC: y[n] = x[n] - x[n-1] + R * y[n-1]
+// Coefs::r define o polo (ex.: 0,995 -> corte de ~6 Hz a 8 kHz)
+template <typename T, typename Coefs>
+class BloqueadorDC {
+public:
+    bool passo(T &x) {
+        if (!iniciado_) {
+            // Começa do primeiro valor para não gerar um transitório do offset do ADC
+            x_anterior_ = x;
+            iniciado_ = true;
+        }
+        T y = x - x_anterior_ + r * y_anterior_;
+        x_anterior_ = x;
+        y_anterior_ = y;
+        x = y;
+        return true;
+    }
+    bool fim_bloco(T &) { return true; }
+
+private:
+    static constexpr T r = static_cast<T>(Coefs::r);
+    T x_anterior_{};
+    T y_anterior_{};
+    bool iniciado_ = false;
+};
+
+// Cascata de biquads; Coefs::secoes é um array constexpr de SecaoBiquad
+template <typename T, typename Coefs>
+class CascataBiquad {
+public:
+    bool passo(T &x) {
+        for (std::size_t i = 0; i < num_secoes; i++) {
+            const SecaoBiquad &c = Coefs::secoes[i];
+            T y = static_cast<T>(c.b0) * x + z1_[i];
+            z1_[i] = static_cast<T>(c.b1) * x - static_cast<T>(c.a1) * y + z2_[i];
+            z2_[i] = static_cast<T>(c.b2) * x - static_cast<T>(c.a2) * y;
+            x = y;
+        }
+        return true;
+    }
+    bool fim_bloco(T &) { return true; }
+
+private:
+    static constexpr std::size_t num_secoes = sizeof(Coefs::secoes) / sizeof(Coefs::secoes[0]);
+    T z1_[num_secoes]{};
+    T z2_[num_secoes]{};
+};
+
+// Cancelador adaptativo de um sinal periódico de frequência conhecida (o tom do buzzer).
+// Em vez de um notch por harmônico, aprende a forma de onda de um período inteiro numa tabela
+// indexada pela fase de um NCO: cada amostra subtrai o valor da sua fase e corrige esse valor
+// em mu * erro. Uma onda quadrada sem filtro anti-aliasing tem harmônicos que, rebatidos pela
+// amostragem, caem a poucos Hz da fundamental (7º e 9º de 999 Hz em 1007 e 991 Hz); como o
+// modelo é uma função da fase, todos eles são removidos juntos, a um custo fixo por amostra.
+// O NCO de 64 bits mantém a fase presa ao tom por horas, e o modelo é guardado entre um
+// acionamento e outro. Se a fase do tom mudar e o bloco sair com mais potência do que entrou,
+// o modelo é descartado e aprendido de novo, começando com passos maiores.
+// Coefs: frequencia e taxa (Hz), bits_modelo (2^bits_modelo pontos por período), passo
+// (mu = 2^-passo depois da partida), blocos_por_passo (duração de cada passo da partida) e
+// escala (2^escala por unidade de T na conversão para inteiro). Só atua enquanto ativo.
+template <typename T, typename Coefs>
+class CanceladorTom {
+public:
+    void ativar(bool ativo) { ativo_ = ativo; }
+    bool ativo() const { return ativo_; }
+
+    bool passo(T &x) {
+        fase_ += incremento;
+        if (!ativo_) return true;
+
+        std::int32_t entrada = static_cast<std::int32_t>(x * static_cast<T>(1 << Coefs::escala));
+        std::int32_t &ponto = modelo_[fase_ >> deslocamento_fase];
+        std::int32_t erro = entrada - (ponto >> bits_fracao_modelo);
+        ponto += erro * (std::int32_t(1) << (bits_fracao_modelo - passo_atual_));
+
+        T saida = static_cast<T>(erro) / static_cast<T>(1 << Coefs::escala);
+        potencia_entrada_ += x * x;
+        potencia_saida_ += saida * saida;
+        x = saida;
+        return true;
+    }
+
+    bool fim_bloco(T &) {
+        if (potencia_entrada_ > T{} && potencia_saida_ > T{}) {
+            rejeicao_db_ = T(10) * std::log10(potencia_entrada_ / potencia_saida_);
+        } else {
+            rejeicao_db_ = T{};
+        }
+        potencia_entrada_ = T{};
+        potencia_saida_ = T{};
+        if (!ativo_) return true;
+
+        if (rejeicao_db_ < -margem_reinicio_db) {
+            // O modelo piora a medição (fase do tom mudou): recomeça do zero
+            for (auto &ponto : modelo_) ponto = 0;
+            passo_atual_ = 1;
+            blocos_no_passo_ = 0;
+            reinicios_++;
+        } else if (passo_atual_ < Coefs::passo && ++blocos_no_passo_ >= Coefs::blocos_por_passo) {
+            // Partida rápida: mu = 1/2, 1/4, ... até 2^-passo
+            passo_atual_++;
+            blocos_no_passo_ = 0;
+        }
+        return true;
+    }
+
+    // Potência removida no último bloco (entrada / saída), em dB; 0 quando inativo
+    T rejeicao_db() const { return rejeicao_db_; }
+
+    // Vezes em que o modelo foi descartado por aumentar a potência do bloco
+    std::uint32_t reinicios() const { return reinicios_; }
+
+private:
+    static constexpr int bits_fracao_modelo = 8;
+    static_assert(Coefs::passo >= 1 && Coefs::passo <= bits_fracao_modelo, "passo invalido");
+    static constexpr std::size_t tamanho_modelo = std::size_t(1) << Coefs::bits_modelo;
+    static constexpr int deslocamento_fase = 64 - Coefs::bits_modelo;
+    static constexpr T margem_reinicio_db = T(1);
+    static constexpr std::uint64_t incremento =
+        static_cast<std::uint64_t>(Coefs::frequencia / Coefs::taxa * 18446744073709551616.0 + 0.5);
+
+    std::int32_t modelo_[tamanho_modelo]{};
+    std::uint64_t fase_ = 0;
+    int passo_atual_ = 1;
+    std::size_t blocos_no_passo_ = 0;
+    std::uint32_t reinicios_ = 0;
+    bool ativo_ = false;
+    T potencia_entrada_{};
+    T potencia_saida_{};
+    T rejeicao_db_{};
+};
+
+// Decimador: deixa passar uma a cada M amostras
+template <typename T, std::size_t M>
+class Decimador {
+    static_assert(M > 0, "fator de decimacao invalido");
+
+public:
+    bool passo(T &) {
+        if (++fase_ < M) return false;
+        fase_ = 0;
+        return true;
+    }
+    bool fim_bloco(T &) { return true; }
+
+private:
+    std::size_t fase_ = 0;
+};
+
+// Integrador RMS sobre N amostras por bloco (as que chegam a ele, já decimadas)
+template <typename T, std::size_t N>
+class IntegradorRMS {
+    static_assert(N > 0, "bloco vazio");
+
+public:
+    bool passo(T &x) {
+        soma_quadrados_ += x * x;
+        return false; // Consome a amostra; o resultado sai em fim_bloco()
+    }
+    bool fim_bloco(T &x) {
+        ultimo_ = std::sqrt(soma_quadrados_ * inverso_n);
+        soma_quadrados_ = T{};
+        x = ultimo_;
+        return true;
+    }
+
+    // Valor RMS do último bloco, antes dos estágios seguintes
+    T ultimo() const { return ultimo_; }
+
+private:
+    static constexpr T inverso_n = T(1) / T(N);
+    T soma_quadrados_{};
+    T ultimo_{};
+};
+
+// Conversor de valor RMS (em contagens do ADC) para dB com a calibração de Coefs:
+// volts_por_contagem, sensibilidade (V/Pa) e referencia (Pa)
+template <typename T, typename Coefs>
+class ConversorDB {
+public:
+    bool passo(T &x) {
+        x = converter(x);
+        return true;
+    }
+    bool fim_bloco(T &x) {
+        x = converter(x);
+        return true;
+    }
+
+private:
+    static constexpr T pascal_por_contagem =
+        static_cast<T>(Coefs::volts_por_contagem / Coefs::sensibilidade / Coefs::referencia);
+    static constexpr T minimo = static_cast<T>(1e-9);
+
+    static T converter(T x) {
+        T relacao = x * pascal_por_contagem;
+        if (relacao < minimo) relacao = minimo; // Evita log de zero
+        return T(20) * std::log10(relacao);
+    }
+};
+
+// Composição de estágios em um único laço por bloco de N amostras de entrada.
+// Cada amostra atravessa a cadeia até o primeiro estágio que a consome; no fim do bloco,
+// os estágios de bloco produzem o resultado.
+template <typename T, std::size_t N, typename... Estagios>
+class Pipeline {
+public:
+    static constexpr std::size_t tamanho_bloco = N;
+
+    template <typename Entrada>
+    T processar(const Entrada *entrada) {
+        for (std::size_t i = 0; i < N; i++) {
+            T x = static_cast<T>(entrada[i]);
+            passo(x, std::index_sequence_for<Estagios...>{});
+        }
+        T resultado{};
+        fim_bloco(resultado, std::index_sequence_for<Estagios...>{});
+        return resultado;
+    }
+
+    template <std::size_t I>
+    auto &estagio() { return std::get<I>(estagios_); }
+
+private:
+    std::tuple<Estagios...> estagios_;
+
+    template <std::size_t... I>
+    void passo(T &x, std::index_sequence<I...>) {
+        (void)(std::get<I>(estagios_).passo(x) && ...);
+    }
+
+    template <std::size_t... I>
+    void fim_bloco(T &x, std::index_sequence<I...>) {
+        (void)(std::get<I>(estagios_).fim_bloco(x) && ...);
+    }
+};
+
+} // namespace dsp
+
+#endif // DSP_PIPELINE_HPP
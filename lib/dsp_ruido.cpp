@@ -0,0 +1,22 @@
+#include "dsp_ruido.h"
+#include "dsp_medicao.hpp"
+
+namespace {
+
+medicao::Cadeia cadeia;
+
+} // namespace
+
+extern "C" float dsp_processar_bloco(const uint16_t *amostras, float *rms_contagens) {
+    float db = cadeia.processar(amostras);
+    if (rms_contagens) *rms_contagens = cadeia.estagio<medicao::ESTAGIO_RMS>().ultimo();
+    return db;
+}
+
+extern "C" void dsp_cancelar_buzzer(bool ativo) {
+    cadeia.estagio<medicao::ESTAGIO_BUZZER>().ativar(ativo);
+}
+
+extern "C" float dsp_rejeicao_buzzer_db(void) {
+    return cadeia.estagio<medicao::ESTAGIO_BUZZER>().rejeicao_db();
+}
@@ -0,0 +1,36 @@
+#ifndef DSP_RUIDO_H
+#define DSP_RUIDO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bloco de medição: 10 ms a 8 kHz
+#define DSP_TAXA_HZ        8000
+#define DSP_AMOSTRAS_BLOCO 80
+
+// PWM do buzzer (relógio do sistema / divisor / (wrap + 1)): ~999 Hz. emitir_som_buzzer() usa os
+// mesmos valores, então o cancelador conhece a frequência exata do tom.
+#define DSP_BUZZER_CLOCK_HZ       125000000.0
+#define DSP_BUZZER_CLKDIV         125
+#define DSP_BUZZER_WRAP           1000
+#define DSP_BUZZER_FREQUENCIA_HZ  (DSP_BUZZER_CLOCK_HZ / DSP_BUZZER_CLKDIV / (DSP_BUZZER_WRAP + 1))
+
+// Processa um bloco de amostras brutas do ADC e retorna o nível em dB SPL.
+// Se rms_contagens não for NULL, recebe o valor RMS do bloco (em contagens do ADC).
+float dsp_processar_bloco(const uint16_t *amostras, float *rms_contagens);
+
+// Liga o cancelamento do tom do buzzer (e harmônicos) antes do cálculo do nível
+void dsp_cancelar_buzzer(bool ativo);
+
+// Potência removida pelo cancelador no último bloco, em dB (0 com o buzzer desligado)
+float dsp_rejeicao_buzzer_db(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_RUIDO_H
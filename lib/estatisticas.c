@@ -0,0 +1,73 @@
+#include "estatisticas.h"
+#include <string.h>
+
+// Converte um nível em dB no índice da classe correspondente do histograma
+static int classe_do_nivel(float db) {
+    int indice = (int)((db - ESTAT_DB_MIN) / ESTAT_RESOLUCAO);
+    if (indice < 0) indice = 0;
+    if (indice >= ESTAT_NUM_CLASSES) indice = ESTAT_NUM_CLASSES - 1;
+    return indice;
+}
+
+// Zera o histograma para iniciar um novo intervalo de medição
+void estat_reset(estat_histograma_t *h) {
+    memset(h->classes, 0, sizeof(h->classes));
+    h->total = 0;
+    h->minimo = 0.0f;
+    h->maximo = 0.0f;
+}
+
+// Acumula um nível de curta duração (em dB SPL) no histograma
+void estat_adicionar(estat_histograma_t *h, float db) {
+    if (h->total == 0 || db < h->minimo) h->minimo = db;
+    if (h->total == 0 || db > h->maximo) h->maximo = db;
+    h->classes[classe_do_nivel(db)]++;
+    h->total++;
+}
+
+// Soma o histograma de origem ao de destino (ex.: intervalos de 1 minuto -> 1 hora)
+void estat_mesclar(estat_histograma_t *destino, const estat_histograma_t *origem) {
+    if (origem->total == 0) return;
+    for (int i = 0; i < ESTAT_NUM_CLASSES; i++) {
+        destino->classes[i] += origem->classes[i];
+    }
+    if (destino->total == 0 || origem->minimo < destino->minimo) destino->minimo = origem->minimo;
+    if (destino->total == 0 || origem->maximo > destino->maximo) destino->maximo = origem->maximo;
+    destino->total += origem->total;
+}
+
+// Retorna o nível Ln excedido em "percentual" % do tempo (ex.: 10 -> L10).
+// Equivale ao quantil (100 - percentual) % da distribuição, com erro máximo de meia classe.
+float estat_nivel_excedido(const estat_histograma_t *h, float percentual) {
+    if (h->total == 0) return 0.0f;
+
+    // Posição (1..total) da amostra procurada na sequência ordenada
+    float fracao = (100.0f - percentual) / 100.0f;
+    uint32_t posicao = (uint32_t)(fracao * h->total);
+    if ((float)posicao < fracao * h->total) posicao++;
+    if (posicao < 1) posicao = 1;
+    if (posicao > h->total) posicao = h->total;
+
+    uint32_t acumulado = 0;
+    for (int i = 0; i < ESTAT_NUM_CLASSES; i++) {
+        acumulado += h->classes[i];
+        if (acumulado >= posicao) {
+            float nivel = ESTAT_DB_MIN + (i + 0.5f) * ESTAT_RESOLUCAO;
+            // As classes extremas também acumulam valores fora da faixa
+            if (nivel < h->minimo) nivel = h->minimo;
+            if (nivel > h->maximo) nivel = h->maximo;
+            return nivel;
+        }
+    }
+    return h->maximo;
+}
+
+// Calcula L10, L50 e L90 de uma só vez
+void estat_calcular_niveis(const estat_histograma_t *h, estat_niveis_t *niveis) {
+    niveis->l10 = estat_nivel_excedido(h, 10.0f);
+    niveis->l50 = estat_nivel_excedido(h, 50.0f);
+    niveis->l90 = estat_nivel_excedido(h, 90.0f);
+    niveis->minimo = h->minimo;
+    niveis->maximo = h->maximo;
+    niveis->amostras = h->total;
+}
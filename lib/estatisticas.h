@@ -0,0 +1,39 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Faixa coberta pelo histograma (em dB SPL) e resolução de 0,1 dB por classe. Cobre a escala
+// do medidor com folga: 1 contagem RMS do ADC dá ~75 dB e o fundo de escala ~141 dB.
+#define ESTAT_DB_MIN      60.0f
+#define ESTAT_DB_MAX      145.0f
+#define ESTAT_RESOLUCAO   0.1f
+#define ESTAT_NUM_CLASSES 850
+
+// Histograma de níveis com memória constante, independente da duração do intervalo.
+// Níveis fora da faixa são acumulados na primeira ou na última classe.
+typedef struct {
+    uint32_t classes[ESTAT_NUM_CLASSES];
+    uint32_t total;
+    float minimo;
+    float maximo;
+} estat_histograma_t;
+
+// Níveis estatísticos Ln calculados a partir de um histograma
+typedef struct {
+    float l10;
+    float l50;
+    float l90;
+    float minimo;
+    float maximo;
+    uint32_t amostras;
+} estat_niveis_t;
+
+void estat_reset(estat_histograma_t *h);
+void estat_adicionar(estat_histograma_t *h, float db);
+void estat_mesclar(estat_histograma_t *destino, const estat_histograma_t *origem);
+float estat_nivel_excedido(const estat_histograma_t *h, float percentual);
+void estat_calcular_niveis(const estat_histograma_t *h, estat_niveis_t *niveis);
+
+#endif // ESTATISTICAS_H
@@ -0,0 +1,129 @@
+#include "fluxo_pcm.h"
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+#include <stdio.h>
+
+// Acesso à CDC, que o pico_stdio_usb também usa. O SDK protege a CDC com um mutex interno (não
+// exportado) e roda o tud_task() numa interrupção de baixa prioridade. Como o mutex não está
+// ao alcance deste módulo:
+// - durante o fluxo o driver USB sai do stdio: nenhum printf chega à USB no meio de um pacote
+//   (o texto segue pela UART);
+// - pacotes e comandos passam por stdio_usb.out_chars()/in_chars(), que tomam o mutex;
+// - as consultas diretas ao TinyUSB são feitas com as interrupções desligadas, para o
+//   tud_task() da interrupção não rodar no meio delas.
+
+static bool ativo = false;
+static uint32_t sequencia = 0;
+static fluxo_pcm_estatisticas_t estatisticas;
+
+static uint16_t crc16(const uint8_t *dados, int n) {
+    uint16_t crc = FLUXO_PCM_CRC_INICIAL;
+    for (int i = 0; i < n; i++) {
+        crc ^= (uint16_t)dados[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void escrever_u16(uint8_t *p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void escrever_u32(uint8_t *p, uint32_t v) {
+    escrever_u16(p, v & 0xFFFF);
+    escrever_u16(p + 2, v >> 16);
+}
+
+static bool cdc_conectada(void) {
+    uint32_t interrupcoes = save_and_disable_interrupts();
+    bool conectada = tud_cdc_connected();
+    restore_interrupts(interrupcoes);
+    return conectada;
+}
+
+static uint32_t cdc_espaco_livre(void) {
+    uint32_t interrupcoes = save_and_disable_interrupts();
+    uint32_t livre = tud_cdc_write_available();
+    restore_interrupts(interrupcoes);
+    return livre;
+}
+
+// Tira o driver USB do stdio (ou o devolve) sem que um printf de interrupção encontre a lista
+// de drivers pela metade
+static void stdio_na_usb(bool habilitado) {
+    uint32_t interrupcoes = save_and_disable_interrupts();
+    stdio_set_driver_enabled(&stdio_usb, habilitado);
+    restore_interrupts(interrupcoes);
+}
+
+// Durante o fluxo o printf deixa de ir para a USB (segue na UART) para não misturar texto
+// com os pacotes binários. A mensagem de início sai antes de o driver ser desligado, então
+// fica na fila da CDC antes do primeiro pacote.
+static void alternar(bool ligar) {
+    if (ligar == ativo) return;
+    if (ligar) {
+        printf("[FLUXO] Enviando amostras brutas pela USB.\n");
+        stdio_na_usb(false);
+        sequencia = 0;
+        estatisticas.pacotes = 0;
+        estatisticas.descartados = 0;
+    } else {
+        stdio_na_usb(true);
+        printf("[FLUXO] Encerrado: %lu pacotes, %lu descartados.\n",
+               (unsigned long)estatisticas.pacotes, (unsigned long)estatisticas.descartados);
+    }
+    ativo = ligar;
+}
+
+// Lê comandos pendentes na USB sem bloquear (o driver é usado diretamente porque fica
+// desabilitado no stdio enquanto o fluxo está ativo)
+void fluxo_pcm_verificar_comandos(void) {
+    char c;
+    while (stdio_usb.in_chars(&c, 1) == 1) {
+        if (c == FLUXO_PCM_CMD_INICIAR) alternar(true);
+        else if (c == FLUXO_PCM_CMD_PARAR) alternar(false);
+    }
+    // Sem terminal aberto do outro lado não há para quem enviar
+    if (ativo && !cdc_conectada()) alternar(false);
+}
+
+bool fluxo_pcm_ativo(void) {
+    return ativo;
+}
+
+// Envia um bloco como um pacote. Se o buffer de transmissão da CDC não tiver espaço, o pacote
+// é descartado em vez de bloquear a medição; o host percebe a falha pela sequência.
+void fluxo_pcm_enviar(uint32_t indice, const uint16_t *amostras, uint16_t n) {
+    if (!ativo) return;
+    if (n > FLUXO_PCM_AMOSTRAS_MAX) n = FLUXO_PCM_AMOSTRAS_MAX;
+
+    uint8_t pacote[FLUXO_PCM_TAMANHO_MAX];
+    escrever_u32(pacote, FLUXO_PCM_MAGICO);
+    escrever_u32(pacote + 4, sequencia++);
+    escrever_u32(pacote + 8, indice);
+    escrever_u16(pacote + 12, n);
+    for (uint16_t i = 0; i < n; i++) {
+        escrever_u16(pacote + FLUXO_PCM_CABECALHO + 2 * i, amostras[i]);
+    }
+    int tamanho = FLUXO_PCM_CABECALHO + 2 * n;
+    escrever_u16(pacote + tamanho, crc16(pacote, tamanho));
+    tamanho += 2;
+
+    // Entre a consulta e a escrita o espaço só pode aumentar (o tud_task() só esvazia a fila),
+    // então out_chars() não chega a esperar
+    if (cdc_espaco_livre() < (uint32_t)tamanho) {
+        estatisticas.descartados++;
+        return;
+    }
+    stdio_usb.out_chars((const char *)pacote, tamanho);
+    estatisticas.pacotes++;
+}
+
+void fluxo_pcm_estatisticas(fluxo_pcm_estatisticas_t *saida) {
+    *saida = estatisticas;
+}
@@ -0,0 +1,33 @@
+#ifndef FLUXO_PCM_H
+#define FLUXO_PCM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Protocolo do fluxo de amostras brutas pela USB CDC (também usado por host/gravador_wav.c).
+// Cada pacote, em little-endian:
+//   magico (u32) | sequencia (u32) | indice da primeira amostra (u32) | n (u16) |
+//   n amostras do ADC (u16, 0 a 4095) | CRC-16/CCITT (u16) de todos os bytes anteriores
+// O índice conta amostras desde o início da captura, então o host detecta tanto pacotes
+// perdidos quanto amostras descartadas no próprio dispositivo.
+#define FLUXO_PCM_MAGICO          0x3150524DUL  // "MRP1"
+#define FLUXO_PCM_CABECALHO       14
+#define FLUXO_PCM_AMOSTRAS_MAX    80
+#define FLUXO_PCM_TAMANHO_MAX     (FLUXO_PCM_CABECALHO + 2 * FLUXO_PCM_AMOSTRAS_MAX + 2)
+#define FLUXO_PCM_CRC_INICIAL     0xFFFF        // Polinômio 0x1021, sem reflexão
+
+// Comandos de um caractere recebidos pela USB
+#define FLUXO_PCM_CMD_INICIAR     'i'
+#define FLUXO_PCM_CMD_PARAR       'p'
+
+typedef struct {
+    uint32_t pacotes;
+    uint32_t descartados;   // Pacotes sem espaço no buffer da CDC
+} fluxo_pcm_estatisticas_t;
+
+void fluxo_pcm_verificar_comandos(void);
+bool fluxo_pcm_ativo(void);
+void fluxo_pcm_enviar(uint32_t indice, const uint16_t *amostras, uint16_t n);
+void fluxo_pcm_estatisticas(fluxo_pcm_estatisticas_t *estatisticas);
+
+#endif // FLUXO_PCM_H
@@ -21,6 +21,10 @@
 #define MEM_ALIGNMENT               4
 #define MEM_SIZE                    4000
 #define MEMP_NUM_TCP_SEG            32
+// PCBs de conexões TCP (o de escuta vem de MEMP_NUM_TCP_PCB_LISTEN): as 6 do pool de
+// lib/servidor_http.h mais 4 de conexões fechadas ainda em TIME_WAIT/LAST_ACK. O padrão do
+// lwIP (5) esgotaria antes do pool, e a recusa do servidor nunca aconteceria.
+#define MEMP_NUM_TCP_PCB            10
 #define MEMP_NUM_ARP_QUEUE          10
 #define PBUF_POOL_SIZE              24
 #define LWIP_ARP                    1
@@ -0,0 +1,389 @@
+#include "servidor_http.h"
+#include <stdio.h>
+#include <string.h>
+
+// O lwIP precisa de um PCB para cada conexão do pool e para as que ainda estão fechando; com
+// menos, tcp_alloc() falha antes do pool esgotar e o servidor nunca chega a recusar conexões
+#if MEMP_NUM_TCP_PCB < SERVIDOR_HTTP_CONEXOES + SERVIDOR_HTTP_PCBS_FOLGA
+#error "MEMP_NUM_TCP_PCB (lwipopts.h) menor que SERVIDOR_HTTP_CONEXOES + SERVIDOR_HTTP_PCBS_FOLGA"
+#endif
+
+typedef enum {
+    CONEXAO_LIVRE,
+    CONEXAO_LENDO,      // Aguardando (o resto de) uma requisição
+    CONEXAO_ENVIANDO,   // Resposta sendo enfileirada/confirmada
+    CONEXAO_FECHANDO    // tcp_close() falhou por falta de memória; tenta de novo no poll
+} conexao_estado_t;
+
+struct servidor_http_conexao {
+    struct tcp_pcb *pcb;
+    conexao_estado_t estado;
+
+    char requisicao[SERVIDOR_HTTP_REQUISICAO_MAX];
+    uint16_t tamanho_requisicao;
+
+    // Resposta em andamento: cabeçalho HTTP, prefixo e corpo
+    char cabecalho[SERVIDOR_HTTP_CABECALHO_MAX];
+    char corpo[SERVIDOR_HTTP_CORPO_MAX];
+    const uint8_t *partes[3];
+    uint32_t tamanhos[3];
+    int parte;
+    uint32_t enviado;
+    uint32_t confirmado;
+    uint32_t total;
+    void (*liberar)(void *contexto);
+    void *contexto;
+
+    bool manter_viva;       // Keep-alive negociado para a requisição atual
+    bool cliente_fechou;    // FIN recebido: fecha assim que a resposta drenar
+    uint8_t ocioso;         // Chamadas de poll sem atividade
+    uint16_t requisicoes;
+};
+
+static servidor_http_conexao_t conexoes[SERVIDOR_HTTP_CONEXOES];
+static servidor_http_estatisticas_t estatisticas;
+static servidor_http_rota_t rota_aplicacao;
+
+static err_t processar_requisicao(servidor_http_conexao_t *c);
+
+static servidor_http_conexao_t *conexao_alocar(struct tcp_pcb *pcb) {
+    for (int i = 0; i < SERVIDOR_HTTP_CONEXOES; i++) {
+        servidor_http_conexao_t *c = &conexoes[i];
+        if (c->estado == CONEXAO_LIVRE) {
+            c->pcb = pcb;
+            c->estado = CONEXAO_LENDO;
+            c->tamanho_requisicao = 0;
+            c->liberar = NULL;
+            c->manter_viva = false;
+            c->cliente_fechou = false;
+            c->ocioso = 0;
+            c->requisicoes = 0;
+            if (++estatisticas.ativas > estatisticas.max_ativas) estatisticas.max_ativas = estatisticas.ativas;
+            return c;
+        }
+    }
+    return NULL;
+}
+
+// Devolve a entrada ao pool, liberando o corpo da resposta se ainda estiver reservado
+static void conexao_liberar(servidor_http_conexao_t *c) {
+    if (c->liberar) {
+        c->liberar(c->contexto);
+        c->liberar = NULL;
+    }
+    c->pcb = NULL;
+    c->estado = CONEXAO_LIVRE;
+    estatisticas.ativas--;
+}
+
+static void desassociar(struct tcp_pcb *pcb) {
+    tcp_arg(pcb, NULL);
+    tcp_recv(pcb, NULL);
+    tcp_sent(pcb, NULL);
+    tcp_err(pcb, NULL);
+    tcp_poll(pcb, NULL, 0);
+}
+
+// Fecha a conexão de forma ordenada; se o lwIP não tiver memória, tenta de novo no próximo poll
+static err_t conexao_fechar(servidor_http_conexao_t *c) {
+    struct tcp_pcb *pcb = c->pcb;
+    if (tcp_close(pcb) != ERR_OK) {
+        c->estado = CONEXAO_FECHANDO;
+        return ERR_OK;
+    }
+    desassociar(pcb);
+    conexao_liberar(c);
+    return ERR_OK;
+}
+
+// Aborta a conexão; o ERR_ABRT retornado deve ser repassado ao lwIP pelo callback
+static err_t conexao_abortar(servidor_http_conexao_t *c) {
+    struct tcp_pcb *pcb = c->pcb;
+    desassociar(pcb);
+    conexao_liberar(c);
+    estatisticas.erros++;
+    tcp_abort(pcb);
+    return ERR_ABRT;
+}
+
+// Enfileira o quanto couber, no máximo um segmento por escrita. Nada é copiado: as partes
+// ficam na própria conexão, na flash ou em RAM reservada até a confirmação.
+static err_t enviar_partes(servidor_http_conexao_t *c) {
+    while (c->parte < 3) {
+        uint32_t restante = c->tamanhos[c->parte] - c->enviado;
+        if (restante == 0) {
+            c->parte++;
+            c->enviado = 0;
+            continue;
+        }
+        uint32_t n = tcp_sndbuf(c->pcb);
+        if (n == 0) break;
+        if (n > restante) n = restante;
+        if (n > TCP_MSS) n = TCP_MSS;
+
+        u8_t flags = (c->parte < 2) ? TCP_WRITE_FLAG_MORE : 0;
+        err_t r = tcp_write(c->pcb, c->partes[c->parte] + c->enviado, (u16_t)n, flags);
+        if (r == ERR_MEM) break; // Tenta de novo quando houver confirmação
+        if (r != ERR_OK) return r;
+        c->enviado += n;
+    }
+    tcp_output(c->pcb);
+    return ERR_OK;
+}
+
+// Resposta confirmada por completo: reutiliza a conexão ou fecha
+static err_t resposta_concluida(servidor_http_conexao_t *c) {
+    if (c->liberar) {
+        c->liberar(c->contexto);
+        c->liberar = NULL;
+    }
+    if (!c->manter_viva || c->cliente_fechou || c->requisicoes >= SERVIDOR_HTTP_REQUISICOES_MAX) {
+        return conexao_fechar(c);
+    }
+
+    c->estado = CONEXAO_LENDO;
+    c->ocioso = 0;
+    // Requisição seguinte que já chegou enquanto a anterior era enviada (pipelining)
+    if (strstr(c->requisicao, "\r\n\r\n")) {
+        return processar_requisicao(c);
+    }
+    return ERR_OK;
+}
+
+char *servidor_http_corpo(servidor_http_conexao_t *conexao) {
+    return conexao->corpo;
+}
+
+static const char *texto_status(int status) {
+    switch (status) {
+    case 200: return "OK";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 431: return "Request Header Fields Too Large";
+    case 503: return "Service Unavailable";
+    default:  return "";
+    }
+}
+
+void servidor_http_responder(servidor_http_conexao_t *c, const servidor_http_resposta_t *resposta) {
+    uint32_t tamanho_conteudo = resposta->tamanho_prefixo + resposta->tamanho_corpo;
+    int n = snprintf(c->cabecalho, sizeof(c->cabecalho),
+                     "HTTP/1.1 %d %s\r\n%s%s%sContent-Length: %lu\r\nConnection: %s\r\n%s\r\n",
+                     resposta->status, texto_status(resposta->status),
+                     resposta->tipo ? "Content-Type: " : "", resposta->tipo ? resposta->tipo : "",
+                     resposta->tipo ? "\r\n" : "", (unsigned long)tamanho_conteudo,
+                     c->manter_viva ? "keep-alive" : "close", resposta->extras ? resposta->extras : "");
+    if (n >= (int)sizeof(c->cabecalho)) n = sizeof(c->cabecalho) - 1;
+
+    c->partes[0] = (const uint8_t *)c->cabecalho;
+    c->tamanhos[0] = n;
+    c->partes[1] = resposta->prefixo;
+    c->tamanhos[1] = resposta->prefixo ? resposta->tamanho_prefixo : 0;
+    c->partes[2] = resposta->corpo;
+    c->tamanhos[2] = resposta->corpo ? resposta->tamanho_corpo : 0;
+    c->parte = 0;
+    c->enviado = 0;
+    c->confirmado = 0;
+    c->total = c->tamanhos[0] + c->tamanhos[1] + c->tamanhos[2];
+    c->liberar = resposta->liberar;
+    c->contexto = resposta->contexto;
+    c->estado = CONEXAO_ENVIANDO;
+}
+
+// Decide o keep-alive pela versão e pelo cabeçalho Connection
+static bool pede_keep_alive(const char *requisicao) {
+    const char *fim_linha = strstr(requisicao, "\r\n");
+    bool http11 = fim_linha && fim_linha - requisicao >= 8 && strncmp(fim_linha - 8, "HTTP/1.1", 8) == 0;
+    if (strstr(requisicao, "Connection: close") || strstr(requisicao, "connection: close")) return false;
+    if (strstr(requisicao, "Connection: keep-alive") || strstr(requisicao, "connection: keep-alive")) return true;
+    return http11;
+}
+
+// Atende a primeira requisição completa do buffer e mantém no buffer o que vier depois dela.
+// Retorna ERR_ABRT se a conexão precisou ser abortada.
+static err_t processar_requisicao(servidor_http_conexao_t *c) {
+    char *fim = strstr(c->requisicao, "\r\n\r\n");
+    if (!fim) return ERR_OK;
+    fim += 4;
+    char seguinte = *fim;
+    *fim = '\0';
+
+    c->requisicoes++;
+    estatisticas.requisicoes++;
+    if (c->requisicoes > 1) estatisticas.reutilizadas++;
+    c->manter_viva = pede_keep_alive(c->requisicao);
+    c->estado = CONEXAO_LENDO;
+
+    rota_aplicacao(c, c->requisicao);
+    if (c->estado != CONEXAO_ENVIANDO) {
+        // A rota não respondeu: evita deixar o cliente esperando
+        servidor_http_resposta_t erro = { .status = 404 };
+        servidor_http_responder(c, &erro);
+    }
+
+    // Descarta a requisição atendida (corpos de POST não são suportados)
+    *fim = seguinte;
+    uint16_t consumido = (uint16_t)(fim - c->requisicao);
+    memmove(c->requisicao, fim, c->tamanho_requisicao - consumido + 1);
+    c->tamanho_requisicao -= consumido;
+
+    if (enviar_partes(c) != ERR_OK) return conexao_abortar(c);
+    return ERR_OK;
+}
+
+static err_t recv_callback(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err) {
+    (void)err;
+    servidor_http_conexao_t *c = (servidor_http_conexao_t *)arg;
+    if (!c) {
+        if (p) pbuf_free(p);
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+
+    if (p == NULL) {
+        // Cliente encerrou o envio: termina a resposta em andamento e fecha
+        c->cliente_fechou = true;
+        if (c->estado == CONEXAO_ENVIANDO) return ERR_OK;
+        return conexao_fechar(c);
+    }
+
+    c->ocioso = 0;
+    tcp_recved(pcb, p->tot_len);
+
+    uint16_t espaco = sizeof(c->requisicao) - 1 - c->tamanho_requisicao;
+    if (p->tot_len > espaco) {
+        pbuf_free(p);
+        if (c->estado == CONEXAO_LENDO) {
+            // Requisição maior que o buffer: responde 431 e fecha
+            c->tamanho_requisicao = 0;
+            c->requisicao[0] = '\0';
+            c->manter_viva = false;
+            servidor_http_resposta_t erro = { .status = 431 };
+            servidor_http_responder(c, &erro);
+            if (enviar_partes(c) != ERR_OK) return conexao_abortar(c);
+        }
+        return ERR_OK;
+    }
+
+    pbuf_copy_partial(p, c->requisicao + c->tamanho_requisicao, p->tot_len, 0);
+    c->tamanho_requisicao += p->tot_len;
+    c->requisicao[c->tamanho_requisicao] = '\0';
+    pbuf_free(p);
+
+    if (c->estado == CONEXAO_LENDO && strstr(c->requisicao, "\r\n\r\n")) {
+        return processar_requisicao(c);
+    }
+    return ERR_OK;
+}
+
+static err_t sent_callback(void *arg, struct tcp_pcb *pcb, u16_t len) {
+    (void)pcb;
+    servidor_http_conexao_t *c = (servidor_http_conexao_t *)arg;
+    if (!c || c->estado != CONEXAO_ENVIANDO) return ERR_OK;
+
+    c->ocioso = 0;
+    c->confirmado += len;
+    if (c->parte < 3) {
+        if (enviar_partes(c) != ERR_OK) return conexao_abortar(c);
+        return ERR_OK;
+    }
+    if (c->confirmado >= c->total) {
+        return resposta_concluida(c);
+    }
+    return ERR_OK;
+}
+
+// Chamado periodicamente pelo lwIP: expira conexões ociosas, retoma envios travados por
+// falta de memória e completa fechamentos pendentes
+static err_t poll_callback(void *arg, struct tcp_pcb *pcb) {
+    servidor_http_conexao_t *c = (servidor_http_conexao_t *)arg;
+    if (!c) {
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+
+    if (c->estado == CONEXAO_FECHANDO) {
+        return conexao_fechar(c);
+    }
+    if (++c->ocioso >= SERVIDOR_HTTP_OCIOSO_MAX) {
+        estatisticas.expiradas++;
+        if (c->estado == CONEXAO_ENVIANDO) return conexao_abortar(c); // Cliente parou de confirmar
+        return conexao_fechar(c);
+    }
+    if (c->estado == CONEXAO_ENVIANDO && c->parte < 3) {
+        if (enviar_partes(c) != ERR_OK) return conexao_abortar(c);
+    }
+    return ERR_OK;
+}
+
+// O lwIP já liberou o PCB: só devolve a entrada ao pool
+static void err_callback(void *arg, err_t err) {
+    (void)err;
+    servidor_http_conexao_t *c = (servidor_http_conexao_t *)arg;
+    if (c) {
+        estatisticas.erros++;
+        conexao_liberar(c);
+    }
+}
+
+static err_t accept_callback(void *arg, struct tcp_pcb *pcb, err_t err) {
+    (void)arg;
+    if (err != ERR_OK || pcb == NULL) return ERR_VAL;
+
+    servidor_http_conexao_t *c = conexao_alocar(pcb);
+    if (!c) {
+        // Pool esgotado: recusa em vez de aceitar uma conexão sem estado
+        estatisticas.recusadas++;
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+    estatisticas.aceitas++;
+
+    tcp_arg(pcb, c);
+    tcp_recv(pcb, recv_callback);
+    tcp_sent(pcb, sent_callback);
+    tcp_err(pcb, err_callback);
+    tcp_poll(pcb, poll_callback, SERVIDOR_HTTP_POLL_INTERVALO);
+    return ERR_OK;
+}
+
+bool servidor_http_iniciar(uint16_t porta, servidor_http_rota_t rota) {
+    rota_aplicacao = rota;
+
+    struct tcp_pcb *pcb = tcp_new();
+    if (!pcb) {
+        printf("Erro ao criar PCB\n");
+        return false;
+    }
+    if (tcp_bind(pcb, IP_ADDR_ANY, porta) != ERR_OK) {
+        printf("Erro ao ligar o servidor na porta %u\n", porta);
+        tcp_close(pcb);
+        return false;
+    }
+
+    struct tcp_pcb *escuta = tcp_listen(pcb);
+    if (!escuta) {
+        printf("Erro ao colocar o servidor em escuta\n");
+        tcp_close(pcb);
+        return false;
+    }
+    tcp_accept(escuta, accept_callback);
+    return true;
+}
+
+void servidor_http_estatisticas(servidor_http_estatisticas_t *saida) {
+    *saida = estatisticas;
+}
+
+// Estatísticas em JSON (GET /servidor no firmware e no servidor do host); retorna o tamanho
+int servidor_http_estatisticas_json(char *buffer, size_t tamanho) {
+    int n = snprintf(buffer, tamanho,
+                     "{\"ativas\":%lu,\"max_ativas\":%lu,\"aceitas\":%lu,\"recusadas\":%lu,"
+                     "\"requisicoes\":%lu,\"reutilizadas\":%lu,\"expiradas\":%lu,\"erros\":%lu}",
+                     (unsigned long)estatisticas.ativas, (unsigned long)estatisticas.max_ativas,
+                     (unsigned long)estatisticas.aceitas, (unsigned long)estatisticas.recusadas,
+                     (unsigned long)estatisticas.requisicoes, (unsigned long)estatisticas.reutilizadas,
+                     (unsigned long)estatisticas.expiradas, (unsigned long)estatisticas.erros);
+    return n < (int)tamanho ? n : (int)tamanho - 1;
+}
@@ -0,0 +1,61 @@
+#ifndef SERVIDOR_HTTP_H
+#define SERVIDOR_HTTP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lwip/tcp.h"
+
+// Servidor HTTP/1.1 mínimo sobre a API raw do lwIP. Depende apenas do lwIP (não do SDK do
+// Pico), então a mesma lógica de conexões pode ser compilada com o port unix do lwIP.
+//
+// Cada conexão ocupa uma entrada de um pool fixo; quando o pool esgota, novas conexões são
+// recusadas. Conexões ociosas expiram via tcp_poll(), respostas são enviadas em partes
+// conforme tcp_sent() confirma os dados e a conexão é fechada (ou reutilizada com
+// keep-alive) só depois que a resposta termina de drenar.
+#define SERVIDOR_HTTP_CONEXOES        6
+#define SERVIDOR_HTTP_PCBS_FOLGA      4     // PCBs de conexões fechadas em TIME_WAIT/LAST_ACK
+#define SERVIDOR_HTTP_REQUISICAO_MAX  768
+#define SERVIDOR_HTTP_CORPO_MAX       1024
+#define SERVIDOR_HTTP_CABECALHO_MAX   256
+#define SERVIDOR_HTTP_POLL_INTERVALO  2     // Em ciclos do timer do TCP (500 ms): 1 s
+#define SERVIDOR_HTTP_OCIOSO_MAX      10    // Em chamadas de poll: 10 s sem atividade
+#define SERVIDOR_HTTP_REQUISICOES_MAX 100   // Por conexão keep-alive
+
+typedef struct servidor_http_conexao servidor_http_conexao_t;
+
+// Descrição de uma resposta. O prefixo e o corpo precisam continuar válidos até o fim
+// do envio; "liberar" (se não for NULL) é chamada quando eles não forem mais usados.
+typedef struct {
+    int status;
+    const char *tipo;           // Content-Type (NULL se não houver corpo)
+    const char *extras;         // Cabeçalhos adicionais, cada um terminado em "\r\n"
+    const uint8_t *prefixo;
+    uint32_t tamanho_prefixo;
+    const uint8_t *corpo;
+    uint32_t tamanho_corpo;
+    void (*liberar)(void *contexto);
+    void *contexto;
+} servidor_http_resposta_t;
+
+// Chamada para cada requisição completa; deve chamar servidor_http_responder() uma vez
+typedef void (*servidor_http_rota_t)(servidor_http_conexao_t *conexao, const char *requisicao);
+
+typedef struct {
+    uint32_t ativas;
+    uint32_t max_ativas;
+    uint32_t aceitas;
+    uint32_t recusadas;         // Pool esgotado
+    uint32_t requisicoes;
+    uint32_t reutilizadas;      // Requisições atendidas em conexões keep-alive
+    uint32_t expiradas;         // Fechadas por ociosidade
+    uint32_t erros;             // Abortadas pelo lwIP ou por falha de envio
+} servidor_http_estatisticas_t;
+
+bool servidor_http_iniciar(uint16_t porta, servidor_http_rota_t rota);
+void servidor_http_responder(servidor_http_conexao_t *conexao, const servidor_http_resposta_t *resposta);
+char *servidor_http_corpo(servidor_http_conexao_t *conexao);
+void servidor_http_estatisticas(servidor_http_estatisticas_t *estatisticas);
+int servidor_http_estatisticas_json(char *buffer, size_t tamanho);
+
+#endif // SERVIDOR_HTTP_H
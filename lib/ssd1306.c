@@ -1,8 +1,10 @@
 #include "ssd1306.h"
 #include "font.h"
+#include <string.h>
 
 // Função de inicialização do display SSD1306
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+    (void)external_vcc;
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8U;
@@ -72,6 +74,40 @@ void ssd1306_send_data(ssd1306_t *ssd) {
     );
 }
 
+// Função para enviar ao display apenas a região x0..x1, y0..y1 (inclusive) do buffer.
+// As linhas são arredondadas para páginas de 8 pixels. Em endereçamento vertical a janela é
+// percorrida coluna a coluna, então os bytes de cada coluna são copiados em sequência.
+void ssd1306_send_region(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    static uint8_t regiao[WIDTH * HEIGHT / 8 + 1];
+    if (x1 >= ssd->width) x1 = ssd->width - 1;
+    if (y1 >= ssd->height) y1 = ssd->height - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    uint8_t pagina0 = y0 >> 3;
+    uint8_t pagina1 = y1 >> 3;
+    uint8_t paginas = pagina1 - pagina0 + 1;
+    size_t n = 1;
+    regiao[0] = 0x40;
+    for (uint8_t x = x0; x <= x1 && x < ssd->width; ++x) {
+        memcpy(&regiao[n], &ssd->ram_buffer[(x << 3) + pagina0 + 1], paginas);
+        n += paginas;
+    }
+
+    ssd1306_command(ssd, SET_COL_ADDR);
+    ssd1306_command(ssd, x0);
+    ssd1306_command(ssd, x1);
+    ssd1306_command(ssd, SET_PAGE_ADDR);
+    ssd1306_command(ssd, pagina0);
+    ssd1306_command(ssd, pagina1);
+    i2c_write_blocking(
+        ssd->i2c_port,
+        ssd->address,
+        regiao,
+        n,
+        false
+    );
+}
+
 // Função para desenhar um pixel no display SSD1306
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     uint16_t index = (y >> 3) + (x << 3) + 1;
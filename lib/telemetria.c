@@ -0,0 +1,85 @@
+#include "telemetria.h"
+#include "wifi_config.h"
+#include "lwip/udp.h"
+#include "pico/unique_id.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static struct udp_pcb *pcb_telemetria = NULL;
+static ip_addr_t endereco_coletor;
+static char id_dispositivo[TELEMETRIA_TAMANHO_ID];
+static uint32_t sequencia = 0;
+
+// Energia acumulada desde o último envio (Leq = média da energia, não dos dB)
+static float soma_energia = 0.0f;
+static uint32_t num_niveis = 0;
+static float nivel_maximo = 0.0f;
+
+// Prepara o socket UDP e o identificador da placa (ID único da flash)
+void telemetria_iniciar(void) {
+    pico_get_unique_board_id_string(id_dispositivo, sizeof(id_dispositivo));
+    if (!ipaddr_aton(COLETOR_IP, &endereco_coletor)) {
+        printf("Endereço do coletor inválido: %s\n", COLETOR_IP);
+        return;
+    }
+
+    cyw43_arch_lwip_begin();
+    pcb_telemetria = udp_new();
+    cyw43_arch_lwip_end();
+    if (!pcb_telemetria) {
+        printf("Erro ao criar PCB de telemetria\n");
+        return;
+    }
+    printf("Telemetria para %s:%d (dispositivo %s, zona %s)\n", COLETOR_IP, TELEMETRIA_PORTA, id_dispositivo, ZONA_ID);
+}
+
+// Acumula o nível de um bloco de medição
+void telemetria_acumular(float db) {
+    soma_energia += powf(10.0f, db / 10.0f);
+    if (num_niveis == 0 || db > nivel_maximo) nivel_maximo = db;
+    num_niveis++;
+}
+
+// Calcula Leq e máximo do período acumulado e reinicia o acúmulo; false se não houve níveis
+bool telemetria_fechar(float *leq, float *maximo) {
+    if (num_niveis == 0) return false;
+    *leq = 10.0f * log10f(soma_energia / num_niveis);
+    *maximo = nivel_maximo;
+    soma_energia = 0.0f;
+    num_niveis = 0;
+    return true;
+}
+
+// Envia uma leitura ao coletor; idade_s > 0 indica uma leitura antiga enviada em lote
+bool telemetria_enviar_medicao(float leq, float maximo, uint32_t idade_s) {
+    if (!pcb_telemetria) return false;
+
+    char mensagem[TELEMETRIA_TAMANHO_MAX];
+    int n;
+    if (idade_s > 0) {
+        n = snprintf(mensagem, sizeof(mensagem), TELEMETRIA_FORMATO_LOTE,
+                     id_dispositivo, ZONA_ID, (unsigned long)++sequencia, leq, maximo, (unsigned long)idade_s);
+    } else {
+        n = snprintf(mensagem, sizeof(mensagem), TELEMETRIA_FORMATO,
+                     id_dispositivo, ZONA_ID, (unsigned long)++sequencia, leq, maximo);
+    }
+
+    cyw43_arch_lwip_begin();
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, n, PBUF_RAM);
+    err_t r = ERR_MEM;
+    if (p) {
+        memcpy(p->payload, mensagem, n);
+        r = udp_sendto(pcb_telemetria, p, &endereco_coletor, TELEMETRIA_PORTA);
+        pbuf_free(p);
+    }
+    cyw43_arch_lwip_end();
+    return r == ERR_OK;
+}
+
+// Envia Leq e máximo do período acumulado e reinicia o acúmulo
+bool telemetria_enviar(void) {
+    float leq, maximo;
+    if (!pcb_telemetria || !telemetria_fechar(&leq, &maximo)) return false;
+    return telemetria_enviar_medicao(leq, maximo, 0);
+}
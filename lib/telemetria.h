@@ -0,0 +1,25 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Protocolo de telemetria para o coletor (host/coletor.c): um datagrama UDP de texto por leitura
+//   MR1 <id> <zona> <sequencia> <leq_db> <max_db> [<idade_s>]
+// A idade só aparece em leituras enviadas em lote (modo de baixo consumo): é há quantos
+// segundos a leitura foi feita, para o coletor colocá-la no intervalo certo.
+// Este cabeçalho não depende do SDK do Pico e também é usado pelas ferramentas do host.
+#define TELEMETRIA_PORTA        5005
+#define TELEMETRIA_TAMANHO_MAX  96
+#define TELEMETRIA_TAMANHO_ID   32
+#define TELEMETRIA_FORMATO      "MR1 %s %s %lu %.1f %.1f\n"
+#define TELEMETRIA_FORMATO_LOTE "MR1 %s %s %lu %.1f %.1f %lu\n"
+#define TELEMETRIA_FORMATO_LER  "MR1 %31s %31s %lu %f %f %lu"
+
+void telemetria_iniciar(void);
+void telemetria_acumular(float db);
+bool telemetria_enviar(void);
+bool telemetria_fechar(float *leq, float *maximo);
+bool telemetria_enviar_medicao(float leq, float maximo, uint32_t idade_s);
+
+#endif // TELEMETRIA_H
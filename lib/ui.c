@@ -0,0 +1,121 @@
+#include "ui.h"
+#include <stdio.h>
+#include <string.h>
+
+void ui_iniciar(ui_t *ui, const ui_saida_t *saida, int num_telas) {
+    memset(ui, 0, sizeof(*ui));
+    ui->saida = *saida;
+    ui->num_telas = num_telas;
+    ui->tela_mudou = true;
+}
+
+// Registra um widget na tela indicada; o valor começa logo após o rótulo.
+// Retorna o índice do widget ou -1 se não houver espaço ou ele não couber na tela.
+int ui_adicionar(ui_t *ui, int tela, uint8_t x, uint8_t y, const char *rotulo, uint8_t caracteres) {
+    if (ui->num_widgets >= UI_MAX_WIDGETS || tela < 0 || tela >= ui->num_telas) return -1;
+    if (caracteres > UI_MAX_CARACTERES) return -1;
+
+    size_t tamanho_rotulo = rotulo ? strlen(rotulo) : 0;
+    if (x + (tamanho_rotulo + caracteres) * UI_CARACTERE_PX > ui->saida.largura) return -1;
+    if (y + UI_CARACTERE_PX > ui->saida.altura) return -1;
+
+    ui_widget_t *w = &ui->widgets[ui->num_widgets];
+    memset(w, 0, sizeof(*w));
+    w->tela = (uint8_t)tela;
+    w->x = x;
+    w->y = y;
+    w->x_valor = (uint8_t)(x + tamanho_rotulo * UI_CARACTERE_PX);
+    w->caracteres = caracteres;
+    w->rotulo = rotulo;
+    memset(w->texto, ' ', caracteres);
+    return ui->num_widgets++;
+}
+
+// Atualiza o valor de um widget; nada é desenhado até ui_desenhar()
+void ui_texto(ui_t *ui, int widget, const char *texto) {
+    if (widget < 0 || widget >= ui->num_widgets) return;
+    ui_widget_t *w = &ui->widgets[widget];
+    size_t n = strlen(texto);
+    if (n > w->caracteres) n = w->caracteres;
+    memcpy(w->texto, texto, n);
+    memset(w->texto + n, ' ', w->caracteres - n);
+}
+
+void ui_numero(ui_t *ui, int widget, const char *formato, float valor) {
+    char buffer[UI_MAX_CARACTERES + 1];
+    snprintf(buffer, sizeof(buffer), formato, valor);
+    ui_texto(ui, widget, buffer);
+}
+
+void ui_mudar_tela(ui_t *ui, int tela) {
+    if (tela < 0 || tela >= ui->num_telas || tela == ui->tela) return;
+    ui->tela = tela;
+    ui->tela_mudou = true;
+}
+
+void ui_proxima_tela(ui_t *ui) {
+    ui_mudar_tela(ui, (ui->tela + 1) % ui->num_telas);
+}
+
+static void desenhar_texto(ui_t *ui, const char *texto, size_t n, uint8_t x, uint8_t y) {
+    for (size_t i = 0; i < n; i++) {
+        ui->saida.caractere(ui->saida.contexto, texto[i], (uint8_t)(x + i * UI_CARACTERE_PX), y);
+    }
+    ui->pixels_quadro += n * UI_CARACTERE_PX * UI_CARACTERE_PX;
+}
+
+// Gera um quadro: na troca de tela redesenha tudo e envia o buffer inteiro; depois disso só
+// rasteriza os caracteres que mudaram e envia a faixa que os contém em cada widget
+void ui_desenhar(ui_t *ui) {
+    ui->pixels_quadro = 0;
+    ui->regioes_quadro = 0;
+    bool completo = ui->tela_mudou;
+
+    if (completo) {
+        ui->saida.limpar(ui->saida.contexto);
+        ui->pixels_quadro += (uint32_t)ui->saida.largura * ui->saida.altura;
+        for (int i = 0; i < ui->num_widgets; i++) {
+            ui_widget_t *w = &ui->widgets[i];
+            if (w->tela != ui->tela) continue;
+            if (w->rotulo) desenhar_texto(ui, w->rotulo, strlen(w->rotulo), w->x, w->y);
+            // Invalida o cache para que todo o valor seja desenhado
+            memset(w->exibido, 0, sizeof(w->exibido));
+        }
+        ui->tela_mudou = false;
+    }
+
+    for (int i = 0; i < ui->num_widgets; i++) {
+        ui_widget_t *w = &ui->widgets[i];
+        if (w->tela != ui->tela) continue;
+
+        int primeiro = -1, ultimo = -1;
+        for (int c = 0; c < w->caracteres; c++) {
+            if (w->texto[c] == w->exibido[c]) continue;
+            ui->saida.caractere(ui->saida.contexto, w->texto[c], (uint8_t)(w->x_valor + c * UI_CARACTERE_PX), w->y);
+            ui->pixels_quadro += UI_CARACTERE_PX * UI_CARACTERE_PX;
+            w->exibido[c] = w->texto[c];
+            if (primeiro < 0) primeiro = c;
+            ultimo = c;
+        }
+
+        if (primeiro >= 0 && !completo) {
+            ui->saida.enviar(ui->saida.contexto,
+                             (uint8_t)(w->x_valor + primeiro * UI_CARACTERE_PX), w->y,
+                             (uint8_t)(w->x_valor + (ultimo + 1) * UI_CARACTERE_PX - 1), (uint8_t)(w->y + UI_CARACTERE_PX - 1));
+            ui->regioes_quadro++;
+        }
+    }
+
+    if (completo) {
+        ui->saida.enviar(ui->saida.contexto, 0, 0, ui->saida.largura - 1, ui->saida.altura - 1);
+        ui->regioes_quadro++;
+    }
+
+    ui->quadros++;
+    ui->pixels_total += ui->pixels_quadro;
+}
+
+void ui_zerar_estatisticas(ui_t *ui) {
+    ui->quadros = 0;
+    ui->pixels_total = 0;
+}
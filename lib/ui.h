@@ -0,0 +1,58 @@
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Interface em modo retido para o display: cada widget guarda o último texto rasterizado e,
+// a cada quadro, só os caracteres que mudaram são redesenhados e enviados. Não depende do
+// SDK do Pico: o desenho é injetado, o que permite contar pixels com uma saída simulada.
+#define UI_MAX_WIDGETS     24
+#define UI_MAX_CARACTERES  16
+#define UI_CARACTERE_PX    8    // Fonte de 8x8 pixels
+
+// Saída gráfica: rasteriza um caractere (com fundo), limpa o quadro e envia uma região
+typedef struct {
+    void (*caractere)(void *contexto, char c, uint8_t x, uint8_t y);
+    void (*limpar)(void *contexto);
+    void (*enviar)(void *contexto, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+    void *contexto;
+    uint8_t largura;
+    uint8_t altura;
+} ui_saida_t;
+
+// Rótulo fixo seguido de um campo de valor com largura fixa em caracteres
+typedef struct {
+    uint8_t tela;
+    uint8_t x, y;
+    uint8_t x_valor;
+    uint8_t caracteres;
+    const char *rotulo;
+    char texto[UI_MAX_CARACTERES + 1];      // Valor atual, completado com espaços
+    char exibido[UI_MAX_CARACTERES + 1];    // Último valor rasterizado
+} ui_widget_t;
+
+typedef struct {
+    ui_widget_t widgets[UI_MAX_WIDGETS];
+    int num_widgets;
+    int num_telas;
+    int tela;
+    bool tela_mudou;    // Próximo quadro redesenha a tela inteira
+    ui_saida_t saida;
+
+    uint32_t quadros;
+    uint32_t pixels_quadro;     // Pixels rasterizados no último quadro
+    uint32_t regioes_quadro;    // Regiões enviadas ao display no último quadro
+    uint64_t pixels_total;
+} ui_t;
+
+void ui_iniciar(ui_t *ui, const ui_saida_t *saida, int num_telas);
+int ui_adicionar(ui_t *ui, int tela, uint8_t x, uint8_t y, const char *rotulo, uint8_t caracteres);
+void ui_texto(ui_t *ui, int widget, const char *texto);
+void ui_numero(ui_t *ui, int widget, const char *formato, float valor);
+void ui_mudar_tela(ui_t *ui, int tela);
+void ui_proxima_tela(ui_t *ui);
+void ui_desenhar(ui_t *ui);
+void ui_zerar_estatisticas(ui_t *ui);
+
+#endif // UI_H
@@ -1,7 +1,12 @@
 #include "wifi_config.h"
 #include "pico/stdlib.h"
+#include "captura_audio.h"
+#include "servidor_http.h"
+#include "dashboard_gz.h"   // Gerado no build por tools/gerar_dashboard.py
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
 
 #define BUTTON_A 5    // Botão A no GPIO5
 #define BUTTON_B 6    // Botão B no GPIO6
@@ -10,10 +15,16 @@
 volatile uint16_t adc_value = 0;
 volatile float amplitude = 0.0f;
 volatile float db_spl = 0.0f;
+volatile float rejeicao_buzzer_db = 0.0f;  // Potência do tom do buzzer removida da medição
+volatile bool buzzer_ativo = false;
+volatile bool wifi_conectado = false;
 
-// Buffer para respostas HTTP
-#define HTTP_RESPONSE_TEMPLATE "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n\r\n" \
-                      "<!DOCTYPE html><html><body>" \
+// Níveis estatísticos do último intervalo fechado e da última hora completa
+volatile estat_niveis_t niveis_intervalo = {0};
+volatile estat_niveis_t niveis_hora = {0};
+
+// Corpo da página simples (/status e ações dos botões), sem JavaScript
+#define HTTP_RESPONSE_TEMPLATE "<!DOCTYPE html><html><body>" \
                       "<h1>Controle dos Botoes</h1>" \
                       "<p><a href=\"/button/a\">Pressionar Botao A</a></p>" \
                       "<p><a href=\"/button/b\">Pressionar Botao B</a></p>" \
@@ -21,19 +32,100 @@ volatile float db_spl = 0.0f;
                       "<p>ADC Bruto: %d</p>" \
                       "<p>Amplitude: %.1f</p>" \
                       "<p>dB SPL: %.1f</p>" \
+                      "<h2>Niveis estatisticos (intervalo)</h2>" \
+                      "<p>L10: %.1f | L50: %.1f | L90: %.1f</p>" \
+                      "<h2>Niveis estatisticos (hora)</h2>" \
+                      "<p>L10: %.1f | L50: %.1f | L90: %.1f</p>" \
+                      "<p><a href=\"/clips\">Trechos de audio gravados</a></p>" \
+                      "<p><a href=\"/\">Dashboard</a></p>" \
                       "</body></html>\r\n"
 
-// Função de callback para processar requisições HTTP
-static err_t http_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
-    if (p == NULL) {
-        // Cliente fechou a conexão
-        tcp_close(tpcb);
-        return ERR_OK;
+// Níveis estatísticos (GET /niveis)
+#define HTTP_NIVEIS_TEMPLATE "{\"intervalo\":{\"l10\":%.1f,\"l50\":%.1f,\"l90\":%.1f,\"min\":%.1f,\"max\":%.1f,\"amostras\":%lu}," \
+                      "\"hora\":{\"l10\":%.1f,\"l50\":%.1f,\"l90\":%.1f,\"min\":%.1f,\"max\":%.1f,\"amostras\":%lu}}"
+
+// Dados ao vivo para o dashboard (GET /dados)
+#define HTTP_DADOS_TEMPLATE "{\"db\":%.1f,\"adc\":%d,\"amplitude\":%.1f,\"l10\":%.1f,\"l50\":%.1f,\"l90\":%.1f,\"buzzer\":%d,\"rejeicao_buzzer\":%.1f}"
+
+#define TIPO_HTML "text/html; charset=utf-8"
+#define TIPO_JSON "application/json"
+
+// Responde com o texto já formatado no buffer da conexão
+static void responder_texto(servidor_http_conexao_t *conexao, const char *tipo, int tamanho) {
+    if (tamanho >= SERVIDOR_HTTP_CORPO_MAX) tamanho = SERVIDOR_HTTP_CORPO_MAX - 1;
+    servidor_http_resposta_t resposta = {
+        .status = 200,
+        .tipo = tipo,
+        .extras = "Cache-Control: no-store\r\n",
+        .corpo = (const uint8_t *)servidor_http_corpo(conexao),
+        .tamanho_corpo = tamanho,
+    };
+    servidor_http_responder(conexao, &resposta);
+}
+
+static void liberar_clip(void *contexto) {
+    captura_liberar((int)(intptr_t)contexto);
+}
+
+// Trecho gravado como WAV: o cabeçalho RIFF vai como prefixo e os dados saem direto do slot,
+// que fica reservado até o envio terminar
+static void responder_clip(servidor_http_conexao_t *conexao, int slot) {
+    if (!captura_reservar(slot)) {
+        servidor_http_resposta_t resposta = { .status = 404 };
+        servidor_http_responder(conexao, &resposta);
+        return;
     }
+    uint8_t *cabecalho_wav = (uint8_t *)servidor_http_corpo(conexao);
+    servidor_http_resposta_t resposta = {
+        .status = 200,
+        .tipo = "audio/wav",
+        .prefixo = cabecalho_wav,
+        .tamanho_prefixo = captura_cabecalho_wav(cabecalho_wav),
+        .corpo = captura_dados(slot),
+        .tamanho_corpo = CAPTURA_BYTES_CLIP,
+        .liberar = liberar_clip,
+        .contexto = (void *)(intptr_t)slot,
+    };
+    servidor_http_responder(conexao, &resposta);
+}
 
-    // Processa a requisição HTTP
-    char *request = (char *)p->payload;
+// Dashboard gzip da flash, ou 304 se o navegador já tem esta versão
+static void responder_dashboard(servidor_http_conexao_t *conexao, const char *request) {
+    const char *condicional = strstr(request, "If-None-Match:");
+    if (condicional && strstr(condicional, DASHBOARD_ETAG)) {
+        servidor_http_resposta_t resposta = {
+            .status = 304,
+            .extras = "ETag: " DASHBOARD_ETAG "\r\n",
+        };
+        servidor_http_responder(conexao, &resposta);
+        return;
+    }
+    servidor_http_resposta_t resposta = {
+        .status = 200,
+        .tipo = TIPO_HTML,
+        .extras = "Content-Encoding: gzip\r\nETag: " DASHBOARD_ETAG "\r\nCache-Control: no-cache\r\n",
+        .corpo = dashboard_gz,
+        .tamanho_corpo = DASHBOARD_TAMANHO,
+    };
+    servidor_http_responder(conexao, &resposta);
+}
+
+// Monta a página com a lista de trechos gravados
+static int listar_clips(char *buffer, size_t tamanho) {
+    int n = snprintf(buffer, tamanho, "<!DOCTYPE html><html><body><h1>Trechos gravados</h1>");
+    for (int i = 0; i < CAPTURA_NUM_SLOTS && n < (int)tamanho; i++) {
+        captura_info_t info;
+        if (!captura_info(i, &info)) continue;
+        n += snprintf(buffer + n, tamanho - n,
+                      "<p><a href=\"/clip/%d.wav\">Disparo %lu</a> - %.1f dB SPL em %lu s</p>",
+                      i, (unsigned long)info.sequencia, info.nivel_db, (unsigned long)(info.instante_ms / 1000));
+    }
+    if (n < (int)tamanho) n += snprintf(buffer + n, tamanho - n, "</body></html>\r\n");
+    return n;
+}
 
+// Roteamento das requisições HTTP
+static void http_rota(servidor_http_conexao_t *conexao, const char *request) {
     if (strstr(request, "GET /button/a")) {
         // Simula a pressão do botão A
         gpio_put(BUTTON_A, 1);
@@ -46,43 +138,43 @@ static err_t http_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_
         gpio_put(BUTTON_B, 0);
     }
 
-    // Atualiza a resposta HTTP com os valores do ADC
-    char http_response[512];
-    snprintf(http_response, sizeof(http_response), HTTP_RESPONSE_TEMPLATE, adc_value, amplitude, db_spl);
-
-    // Envia a resposta HTTP
-    tcp_write(tpcb, http_response, strlen(http_response), TCP_WRITE_FLAG_COPY);
-
-    // Libera o buffer recebido
-    pbuf_free(p);
-
-    return ERR_OK;
-}
-
-// Callback de conexão: associa o http_callback à conexão
-static err_t connection_callback(void *arg, struct tcp_pcb *newpcb, err_t err) {
-    tcp_recv(newpcb, http_callback);  // Associa o callback HTTP
-    return ERR_OK;
+    char *corpo = servidor_http_corpo(conexao);
+    const char *rota_clip = strstr(request, "GET /clip/");
+    if (rota_clip) {
+        responder_clip(conexao, atoi(rota_clip + strlen("GET /clip/")));
+    } else if (strncmp(request, "GET / ", 6) == 0) {
+        responder_dashboard(conexao, request);
+    } else if (strstr(request, "GET /clips")) {
+        responder_texto(conexao, TIPO_HTML, listar_clips(corpo, SERVIDOR_HTTP_CORPO_MAX));
+    } else if (strstr(request, "GET /niveis")) {
+        responder_texto(conexao, TIPO_JSON, snprintf(corpo, SERVIDOR_HTTP_CORPO_MAX, HTTP_NIVEIS_TEMPLATE,
+                 niveis_intervalo.l10, niveis_intervalo.l50, niveis_intervalo.l90,
+                 niveis_intervalo.minimo, niveis_intervalo.maximo, (unsigned long)niveis_intervalo.amostras,
+                 niveis_hora.l10, niveis_hora.l50, niveis_hora.l90,
+                 niveis_hora.minimo, niveis_hora.maximo, (unsigned long)niveis_hora.amostras));
+    } else if (strstr(request, "GET /dados")) {
+        responder_texto(conexao, TIPO_JSON, snprintf(corpo, SERVIDOR_HTTP_CORPO_MAX, HTTP_DADOS_TEMPLATE,
+                 db_spl, adc_value, amplitude,
+                 niveis_intervalo.l10, niveis_intervalo.l50, niveis_intervalo.l90, buzzer_ativo ? 1 : 0,
+                 rejeicao_buzzer_db));
+    } else if (strstr(request, "GET /servidor")) {
+        // Estado do pool de conexões, usado pelo teste de carga para detectar vazamentos
+        responder_texto(conexao, TIPO_JSON, servidor_http_estatisticas_json(corpo, SERVIDOR_HTTP_CORPO_MAX));
+    } else {
+        responder_texto(conexao, TIPO_HTML, snprintf(corpo, SERVIDOR_HTTP_CORPO_MAX, HTTP_RESPONSE_TEMPLATE,
+                 adc_value, amplitude, db_spl,
+                 niveis_intervalo.l10, niveis_intervalo.l50, niveis_intervalo.l90,
+                 niveis_hora.l10, niveis_hora.l50, niveis_hora.l90));
+    }
 }
 
 // Função de setup do servidor TCP
 void start_http_server(void) {
-    struct tcp_pcb *pcb = tcp_new();
-    if (!pcb) {
-        printf("Erro ao criar PCB\n");
-        return;
-    }
-
     // Liga o servidor na porta 80
-    if (tcp_bind(pcb, IP_ADDR_ANY, 80) != ERR_OK) {
-        printf("Erro ao ligar o servidor na porta 80\n");
+    if (!servidor_http_iniciar(80, http_rota)) {
         return;
     }
-
-    pcb = tcp_listen(pcb);  // Coloca o PCB em modo de escuta
-    tcp_accept(pcb, connection_callback);  // Associa o callback de conexão
-
-    printf("Servidor HTTP rodando na porta 80...\n");
+    printf("Servidor HTTP rodando na porta 80 (até %d conexões simultâneas)...\n", SERVIDOR_HTTP_CONEXOES);
 }
 
 void start_wifi() {
@@ -104,6 +196,7 @@ void start_wifi() {
         return;
     } else {
         printf("Connected.\n");
+        wifi_conectado = true;
         // Read the ip address in a human readable way
         uint8_t *ip_address = (uint8_t*)&(cyw43_state.netif[0].ip_addr.addr);
         printf("Endereço IP %d.%d.%d.%d\n", ip_address[0], ip_address[1], ip_address[2], ip_address[3]);
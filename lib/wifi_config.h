@@ -3,10 +3,20 @@
 
 #include "pico/cyw43_arch.h"
 #include "lwip/tcp.h"
+#include "estatisticas.h"
 
 #define WIFI_SSID "Lucas 2.4"  // Substitua pelo nome da sua rede Wi-Fi
 #define WIFI_PASS "369258147" // Substitua pela senha da sua rede Wi-Fi
 
+#define COLETOR_IP "192.168.0.100" // Substitua pelo IP do computador que roda o coletor (host/)
+#define ZONA_ID    "zona1"         // Zona a que este monitor pertence
+
+// Níveis estatísticos publicados pelo laço principal e expostos no servidor HTTP
+extern volatile estat_niveis_t niveis_intervalo;
+extern volatile estat_niveis_t niveis_hora;
+extern volatile bool buzzer_ativo;
+extern volatile bool wifi_conectado;
+
 void start_wifi();
 void start_http_server();
 
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""Gera o cabeçalho C com o dashboard web minificado e comprimido em gzip.
+
+Uso: gerar_dashboard.py <entrada.html> <saida.h>
+
+O array resultante fica em flash (const) e é servido com Content-Encoding: gzip.
+O ETag é derivado do conteúdo comprimido, então muda sempre que a página muda.
+"""
+import gzip
+import hashlib
+import re
+import sys
+
+
+def minificar(html):
+    # Remove comentários HTML, de bloco em CSS/JS e de linha em JS
+    html = re.sub(r'<!--.*?-->', '', html, flags=re.S)
+    html = re.sub(r'/\*.*?\*/', '', html, flags=re.S)
+    html = re.sub(r'^\s*//.*$', '', html, flags=re.M)
+    # Junta as linhas e reduz espaços repetidos
+    linhas = [linha.strip() for linha in html.splitlines()]
+    html = '\n'.join(linha for linha in linhas if linha)
+    html = re.sub(r'>\s+<', '><', html)
+    html = re.sub(r'[ \t]{2,}', ' ', html)
+    return html
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+
+    with open(sys.argv[1], encoding='utf-8') as f:
+        original = f.read()
+    minificado = minificar(original).encode('utf-8')
+    # mtime fixo para que a saída (e o ETag) seja reprodutível
+    comprimido = gzip.compress(minificado, compresslevel=9, mtime=0)
+
+    # Confere a ida e volta antes de gravar o cabeçalho
+    if gzip.decompress(comprimido) != minificado:
+        sys.exit('erro: gzip não reproduz o conteúdo minificado')
+
+    etag = hashlib.sha1(comprimido).hexdigest()[:16]
+    linhas = []
+    for i in range(0, len(comprimido), 16):
+        linhas.append('    ' + ' '.join('0x%02x,' % b for b in comprimido[i:i + 16]))
+
+    with open(sys.argv[2], 'w', encoding='utf-8') as f:
+        f.write('// Gerado por tools/gerar_dashboard.py a partir de %s - não edite\n' % sys.argv[1].replace('\\', '/').split('/')[-1])
+        f.write('// Original: %d bytes | minificado: %d bytes | gzip: %d bytes\n'
+                % (len(original.encode('utf-8')), len(minificado), len(comprimido)))
+        f.write('#ifndef DASHBOARD_GZ_H\n#define DASHBOARD_GZ_H\n\n#include <stdint.h>\n\n')
+        f.write('#define DASHBOARD_ETAG "\\"%s\\""\n' % etag)
+        f.write('#define DASHBOARD_TAMANHO %d\n\n' % len(comprimido))
+        f.write('static const uint8_t dashboard_gz[DASHBOARD_TAMANHO] = {\n')
+        f.write('\n'.join(linhas))
+        f.write('\n};\n\n#endif // DASHBOARD_GZ_H\n')
+
+
+if __name__ == '__main__':
+    main()